@@ -1,11 +1,14 @@
 #include "UI.hh"
+#include "createShape.hh"
+
+#include <cstdio>
 
 /**
- * Draw the right-side UI panel with game information and controls.
+ * Build the right-side UI panel with game information and controls.
  *
  * This panel lives to the right of the puzzle grid. It shows:
  *  - Music status (ON/OFF) and the shortcut key to toggle (M)
- *  - Hints for controls (M, R)
+ *  - Hints for controls (M, R, 3-8, H)
  *  - Live elapsed time (or final time after a win)
  *  - Total move count
  *
@@ -18,56 +21,88 @@
  * Rendering notes:
  *  - Uses fontInfo for all text elements in this panel.
  *  - Colors: red/gray for music status, soft gray for hints, white for data.
- *  - Text sizes: status/time/moves at 50px; hints at 40px.
+ *  - Text sizes: status/time/moves at fontSize; hints at 60% of it.
+ *  - Positions, colors, styles and the static hint strings are set here once.
  */
-void drawUI(sf::RenderWindow &window,
-            const sf::Font &fontInfo,
-            bool musicPlaying,
-            int elapsedSeconds, int finalTime,
-            bool gameWon, int moveCount,
-            float RightX, float TopY,
-            float rightMargin, float gapRight,
-            unsigned int fontSize)
+InfoPanel::InfoPanel(const sf::Font &fontInfo,
+                     float RightX, float TopY,
+                     float rightMargin, float gapRight,
+                     unsigned int fontSize)
+    : m_musicStatus(fontInfo, "", fontSize),
+      m_hints{sf::Text(fontInfo, "Press M to toggle music", static_cast<unsigned int>(fontSize * 0.6f)),
+              sf::Text(fontInfo, "Press R to restart", static_cast<unsigned int>(fontSize * 0.6f)),
+              sf::Text(fontInfo, "Press 3-8 to change size", static_cast<unsigned int>(fontSize * 0.6f)),
+              sf::Text(fontInfo, "Press H for a hint (3x3, 4x4)", static_cast<unsigned int>(fontSize * 0.6f))},
+      m_time(fontInfo, "", fontSize),
+      m_moves(fontInfo, "", fontSize)
 {
     // Music status indicator (shows current state and shortcut key)
     // Position: first line of the panel
-    sf::Text musicStatus(fontInfo,
-                         musicPlaying ? "[ON] Music: (M)" : "[OFF] Music: (M)",
-                         fontSize);
-    // ON = warm red; OFF = neutral gray
-    musicStatus.setFillColor(musicPlaying ? sf::Color(220, 50, 50)
-                                          : sf::Color(150, 150, 150));
-    musicStatus.setStyle(sf::Text::Bold);
-    musicStatus.setPosition(sf::Vector2f(RightX + rightMargin, TopY));
-    window.draw(musicStatus);
+    m_musicStatus.setStyle(sf::Text::Bold);
+    m_musicStatus.setPosition(sf::Vector2f(RightX + rightMargin, TopY));
 
     // Shortcut hints (placed below status with vertical spacing)
-    unsigned int hintSize = static_cast<unsigned int>(fontSize * 0.6f);
-    sf::Text hint1(fontInfo, "Press M to toggle music", hintSize);
-    sf::Text hint2(fontInfo, "Press R to restart", hintSize);
-    hint1.setFillColor(sf::Color(220, 220, 220)); // soft gray, lower emphasis
-    hint2.setFillColor(sf::Color(220, 220, 220));
-    hint1.setPosition(sf::Vector2f(RightX + rightMargin, TopY + gapRight * 2));
-    hint2.setPosition(sf::Vector2f(RightX + rightMargin, TopY + gapRight * 3));
-    window.draw(hint1);
-    window.draw(hint2);
+    for (std::size_t i = 0; i < m_hints.size(); ++i)
+    {
+        m_hints[i].setFillColor(sf::Color(220, 220, 220)); // soft gray, lower emphasis
+        m_hints[i].setPosition(sf::Vector2f(RightX + rightMargin, TopY + gapRight * (2 + i)));
+    }
 
-    // Time: shows live elapsed time until win, then locks to finalTime
-    // Positioned further down to visually separate from hints
-    const int timeValue = gameWon ? finalTime : elapsedSeconds;
-    sf::Text timeText(fontInfo, "TIME  " + std::to_string(timeValue) + "s", fontSize);
-    timeText.setFillColor(sf::Color::White);
-    timeText.setStyle(sf::Text::Bold);
-    timeText.setPosition(sf::Vector2f(RightX + rightMargin, TopY + gapRight * 5));
-    window.draw(timeText);
+    // Time: positioned further down to visually separate from hints
+    m_time.setFillColor(sf::Color::White);
+    m_time.setStyle(sf::Text::Bold);
+    m_time.setPosition(sf::Vector2f(RightX + rightMargin, TopY + gapRight * 6));
 
-    // Moves: total number of player actions (swaps)
-    // Placed one line below time
-    sf::Text moveText(fontInfo, "MOVES  " + std::to_string(moveCount), fontSize);
-    moveText.setFillColor(sf::Color::White);
-    moveText.setStyle(sf::Text::Bold);
-    moveText.setPosition(sf::Vector2f(RightX + rightMargin, TopY + gapRight * 7));
-    window.draw(moveText);
+    // Moves: placed one line below time
+    m_moves.setFillColor(sf::Color::White);
+    m_moves.setStyle(sf::Text::Bold);
+    m_moves.setPosition(sf::Vector2f(RightX + rightMargin, TopY + gapRight * 8));
+}
+
+/**
+ * Update the dynamic panel lines.
+ *
+ * Each line is reformatted only when the value it shows differs from the
+ * one already displayed, e.g. the time text changes once per second.
+ *
+ * @param musicPlaying   Whether background music is playing.
+ * @param elapsedSeconds Elapsed time in seconds (GameState stops it at the win).
+ * @param moveCount      Number of moves made.
+ */
+void InfoPanel::update(bool musicPlaying, int elapsedSeconds, int moveCount)
+{
+    if (m_shownMusic != static_cast<int>(musicPlaying))
+    {
+        m_shownMusic = musicPlaying;
+        m_musicStatus.setString(musicPlaying ? "[ON] Music: (M)" : "[OFF] Music: (M)");
+        // ON = warm red; OFF = neutral gray
+        m_musicStatus.setFillColor(musicPlaying ? sf::Color(220, 50, 50)
+                                                : sf::Color(150, 150, 150));
+    }
+
+    char line[32];
+    if (m_shownTime != elapsedSeconds)
+    {
+        m_shownTime = elapsedSeconds;
+        std::snprintf(line, sizeof(line), "TIME  %ds", elapsedSeconds);
+        setTextString(m_time, m_timeString, line);
+    }
+
+    if (m_shownMoves != moveCount)
+    {
+        m_shownMoves = moveCount;
+        std::snprintf(line, sizeof(line), "MOVES  %d", moveCount);
+        setTextString(m_moves, m_movesString, line);
+    }
+}
+
+void InfoPanel::draw(sf::RenderTarget &target) const
+{
+    target.draw(m_musicStatus);
+    for (const sf::Text &hint : m_hints)
+        target.draw(hint);
+    target.draw(m_time);
+    target.draw(m_moves);
 }
 
 /**
@@ -3,20 +3,45 @@
 
 #include <SFML/Graphics.hpp>
 
-// Draw the right-side UI panel with game information
-// Displays elapsed time, final time (if won), move count, and music status
-void drawUI(sf::RenderWindow &window,
-            const sf::Font &fontInfo, // font used for info text
-            bool musicPlaying,        // whether background music is currently playing
-            int elapsedSeconds,       // current elapsed time in seconds
-            int finalTime,            // time taken to win (if gameWon is true)
-            bool gameWon,             // flag indicating if the puzzle is solved
-            int moveCount,            // number of moves made
-            float RightX,             // starting X position of the right panel
-            float TopY,               // starting Y position of the right panel
-            float rightMargin,        // margin on the right side
-            float gapRight,           // gap between UI elements in the right panel
-            unsigned int fontSize);   // font size for the UI text
+#include <array>
+
+// Right-side UI panel with game information (retained mode)
+// Owns its text objects and lays them out once; update() only rewrites the
+// strings whose value changed, so a steady frame formats and allocates nothing,
+// and changed values are formatted on the stack into reused string storage
+class InfoPanel
+{
+public:
+    InfoPanel(const sf::Font &fontInfo, // font used for info text
+              float RightX,             // starting X position of the right panel
+              float TopY,               // starting Y position of the right panel
+              float rightMargin,        // margin on the right side
+              float gapRight,           // gap between UI elements in the right panel
+              unsigned int fontSize);   // font size for the UI text
+
+    // Refresh the dynamic lines (music status, time, moves) if their values changed
+    void update(bool musicPlaying,  // whether background music is currently playing
+                int elapsedSeconds, // elapsed time in seconds (the game clock stops at the win)
+                int moveCount);     // number of moves made
+
+    // Displays music status, control hints, elapsed time and move count
+    void draw(sf::RenderTarget &target) const;
+
+    static constexpr int DRAW_CALLS = 7;
+
+private:
+    sf::Text m_musicStatus;
+    std::array<sf::Text, 4> m_hints;
+    sf::Text m_time;
+    sf::Text m_moves;
+    sf::String m_timeString; // storage reused by setTextString()
+    sf::String m_movesString;
+
+    // Values currently shown (-1 = not set yet)
+    int m_shownMusic = -1;
+    int m_shownTime = -1;
+    int m_shownMoves = -1;
+};
 
 // Create and return the main game window
 // Window size is calculated based on puzzle size, margins, header height, and right panel width
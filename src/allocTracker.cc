@@ -0,0 +1,187 @@
+#include "allocTracker.hh"
+
+#include <algorithm>
+
+#ifdef PUZZLE15_TRACK_ALLOCS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    constexpr int MAX_SITES = 128;
+    constexpr const char *UNTAGGED = "(untagged)";
+    constexpr const char *OTHER_SITES = "(other sites)";
+
+    // Fixed table so that counting never allocates; slots are claimed once and never released
+    struct SiteSlot
+    {
+        std::atomic<const char *> name{nullptr};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> bytes{0};
+    };
+
+    SiteSlot g_sites[MAX_SITES];
+    thread_local AllocationCounts t_counts;
+    thread_local const char *t_site = nullptr;
+
+    SiteSlot &siteSlot(const char *name)
+    {
+        for (int i = 0; i < MAX_SITES - 1; ++i)
+        {
+            const char *current = g_sites[i].name.load(std::memory_order_acquire);
+            if (current == name)
+                return g_sites[i];
+            if (current == nullptr &&
+                (g_sites[i].name.compare_exchange_strong(current, name, std::memory_order_acq_rel) || current == name))
+                return g_sites[i];
+        }
+        g_sites[MAX_SITES - 1].name.store(OTHER_SITES, std::memory_order_relaxed);
+        return g_sites[MAX_SITES - 1];
+    }
+
+    void count(std::size_t size)
+    {
+        ++t_counts.allocations;
+        t_counts.bytes += size;
+        SiteSlot &slot = siteSlot(t_site ? t_site : UNTAGGED);
+        slot.allocations.fetch_add(1, std::memory_order_relaxed);
+        slot.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void *allocate(std::size_t size)
+    {
+        count(size);
+        return std::malloc(size ? size : 1);
+    }
+
+    void *allocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        count(size);
+        const std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size ? size : 1, align);
+#else
+        // aligned_alloc wants a size that is a multiple of the alignment
+        return std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+#endif
+    }
+
+    void releaseAligned(void *pointer)
+    {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+// Replacements of the global allocation functions (all forms route through allocate/allocateAligned)
+void *operator new(std::size_t size)
+{
+    if (void *pointer = allocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void *pointer = allocateAligned(size, alignment))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocateAligned(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { releaseAligned(pointer); }
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { releaseAligned(pointer); }
+
+AllocationSite::AllocationSite(const char *name) : m_previous(t_site)
+{
+    t_site = name;
+}
+
+AllocationSite::~AllocationSite()
+{
+    t_site = m_previous;
+}
+
+AllocationCounts threadAllocations()
+{
+    return t_counts;
+}
+
+std::vector<SiteAllocations> allocationSites()
+{
+    std::vector<SiteAllocations> sites;
+    sites.reserve(MAX_SITES);
+    for (const SiteSlot &slot : g_sites)
+        if (const char *name = slot.name.load(std::memory_order_acquire))
+            sites.push_back({name, {slot.allocations.load(std::memory_order_relaxed), slot.bytes.load(std::memory_order_relaxed)}});
+    std::sort(sites.begin(), sites.end(), [](const SiteAllocations &a, const SiteAllocations &b)
+              { return a.counts.bytes > b.counts.bytes; });
+    return sites;
+}
+
+#else
+
+AllocationCounts threadAllocations()
+{
+    return {};
+}
+
+std::vector<SiteAllocations> allocationSites()
+{
+    return {};
+}
+
+#endif
+
+void reportAllocationSites(std::ostream &out)
+{
+    if (!ALLOCATION_TRACKING)
+        return;
+    const std::vector<SiteAllocations> sites = allocationSites();
+    out << "Heap allocations per call site (all threads):\n";
+    for (const SiteAllocations &site : sites)
+        out << "  " << site.name << ": " << site.counts.allocations << " allocations, " << site.counts.bytes << " bytes\n";
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Heap allocations counted by the tracking build
+struct AllocationCounts
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+};
+
+// Configure with -DPUZZLE15_TRACK_ALLOCS=ON to replace the global operator new/delete with counting versions
+#ifdef PUZZLE15_TRACK_ALLOCS
+constexpr bool ALLOCATION_TRACKING = true;
+#else
+constexpr bool ALLOCATION_TRACKING = false;
+#endif
+
+// Allocations made by the calling thread since it started (zero without tracking)
+AllocationCounts threadAllocations();
+
+/**
+ * Attributes the calling thread's heap allocations to a named call site
+ * while in scope (nested sites take over until they end).
+ *
+ * The name must be a string literal (sites are told apart by address).
+ * Compiles to nothing without PUZZLE15_TRACK_ALLOCS.
+ */
+class AllocationSite
+{
+public:
+#ifdef PUZZLE15_TRACK_ALLOCS
+    explicit AllocationSite(const char *name);
+    ~AllocationSite();
+
+    AllocationSite(const AllocationSite &) = delete;
+    AllocationSite &operator=(const AllocationSite &) = delete;
+
+private:
+    const char *m_previous;
+#else
+    explicit AllocationSite(const char *) {}
+#endif
+};
+
+struct SiteAllocations
+{
+    const char *name; // "(untagged)" for allocations outside every site
+    AllocationCounts counts;
+};
+
+// Totals per call site over all threads, most bytes first (allocates: call outside frames)
+std::vector<SiteAllocations> allocationSites();
+
+// Print the per-site table (nothing without tracking)
+void reportAllocationSites(std::ostream &out);
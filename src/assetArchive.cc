@@ -0,0 +1,135 @@
+#include "assetArchive.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    constexpr char PAK_MAGIC[8] = {'P', '1', '5', 'P', 'A', 'K', '\0', '\0'};
+
+    std::uint64_t alignUp(std::uint64_t value)
+    {
+        return (value + PAK_ALIGNMENT - 1) / PAK_ALIGNMENT * PAK_ALIGNMENT;
+    }
+}
+
+/**
+ * Map an archive and validate its index.
+ *
+ * Every entry must lie inside the file; nothing else is read up front.
+ *
+ * @param path Archive file.
+ * @return true if the archive is usable.
+ */
+bool AssetArchive::open(const std::string &path)
+{
+    m_entries = nullptr;
+    m_entryCount = 0;
+    if (!m_file.open(path))
+        return false;
+
+    const unsigned char *data = m_file.data();
+    const std::size_t size = m_file.size();
+
+    PakFileHeader header;
+    if (size < sizeof(header))
+    {
+        m_file.close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    const std::uint64_t indexEnd = sizeof(header) + std::uint64_t(header.entryCount) * sizeof(PakEntry);
+    if (std::memcmp(header.magic, PAK_MAGIC, sizeof(PAK_MAGIC)) != 0 || header.version != PAK_VERSION ||
+        indexEnd > size)
+    {
+        m_file.close();
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const PakEntry *>(data + sizeof(header));
+    m_entryCount = header.entryCount;
+    for (std::uint32_t i = 0; i < m_entryCount; ++i)
+        if (m_entries[i].offset > size || m_entries[i].size > size - m_entries[i].offset)
+        {
+            m_entries = nullptr;
+            m_entryCount = 0;
+            m_file.close();
+            return false;
+        }
+    return true;
+}
+
+std::span<const unsigned char> AssetArchive::find(const std::string &name) const
+{
+    if (name.size() >= PAK_NAME_LENGTH)
+        return {};
+
+    // A handful of entries: a linear scan over the index beats anything fancier
+    for (std::uint32_t i = 0; i < m_entryCount; ++i)
+        if (std::strncmp(m_entries[i].name, name.c_str(), PAK_NAME_LENGTH) == 0)
+            return {m_file.data() + m_entries[i].offset, static_cast<std::size_t>(m_entries[i].size)};
+    return {};
+}
+
+/**
+ * Write the header, the index and the 16-byte aligned file contents.
+ *
+ * @return false if a file is missing, a name is too long or the output fails.
+ */
+bool writeAssetArchive(const std::string &root, const std::vector<std::string> &names,
+                       const std::string &path, std::ostream &log)
+{
+    PakFileHeader header{};
+    std::memcpy(header.magic, PAK_MAGIC, sizeof(PAK_MAGIC));
+    header.version = PAK_VERSION;
+    header.entryCount = static_cast<std::uint32_t>(names.size());
+
+    std::vector<PakEntry> entries(names.size());
+    std::vector<std::vector<char>> contents(names.size());
+    std::uint64_t offset = alignUp(sizeof(header) + entries.size() * sizeof(PakEntry));
+
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        if (names[i].size() >= PAK_NAME_LENGTH)
+        {
+            log << "Name too long for the archive index: " << names[i] << "\n";
+            return false;
+        }
+
+        std::ifstream in(root + names[i], std::ios::binary);
+        if (!in)
+        {
+            log << "Cannot read " << root + names[i] << "\n";
+            return false;
+        }
+        contents[i].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+        std::memcpy(entries[i].name, names[i].c_str(), names[i].size());
+        entries[i].offset = offset;
+        entries[i].size = contents[i].size();
+        offset = alignUp(offset + contents[i].size());
+        log << "  " << names[i] << " (" << contents[i].size() << " bytes)\n";
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        log << "Cannot write " << path << "\n";
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(PakEntry));
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        const std::uint64_t padding = entries[i].offset - static_cast<std::uint64_t>(out.tellp());
+        std::fill_n(std::ostreambuf_iterator<char>(out), padding, '\0');
+        out.write(contents[i].data(), contents[i].size());
+    }
+
+    log << "Packed " << names.size() << " files into " << path << " (" << out.tellp() << " bytes)\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "mappedFile.hh"
+
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+// Archive layout: header, entry index, then each file's bytes (16-byte aligned)
+constexpr int PAK_VERSION = 1;
+constexpr int PAK_NAME_LENGTH = 48; // relative path, NUL-padded
+constexpr int PAK_ALIGNMENT = 16;
+
+struct PakFileHeader
+{
+    char magic[8]; // "P15PAK\0\0"
+    std::uint32_t version;
+    std::uint32_t entryCount;
+};
+
+struct PakEntry
+{
+    char name[PAK_NAME_LENGTH]; // e.g. "fonts/Poppins-Bold.ttf"
+    std::uint64_t offset;       // from the start of the file
+    std::uint64_t size;
+};
+
+/**
+ * Read-only view of a packed asset archive.
+ *
+ * The whole archive is one memory mapping; find() returns spans straight
+ * into it, so fonts and music can be handed to SFML's openFromMemory and
+ * streamed from the mapping without any copy. Spans stay valid while the
+ * archive is open.
+ */
+class AssetArchive
+{
+public:
+    // Map an archive; returns false if it is missing or malformed
+    bool open(const std::string &path);
+
+    bool isOpen() const { return m_file.isOpen(); }
+    std::size_t size() const { return m_file.size(); }
+
+    // Bytes of the entry stored under name (empty span if absent)
+    std::span<const unsigned char> find(const std::string &name) const;
+
+private:
+    MappedFile m_file;
+    const PakEntry *m_entries = nullptr;
+    std::uint32_t m_entryCount = 0;
+};
+
+/**
+ * Pack files into an archive readable by AssetArchive.
+ *
+ * @param root   Directory the names are relative to (with trailing separator).
+ * @param names  Files to pack, stored under these relative names.
+ * @param path   Output archive path.
+ * @param log    Progress and error messages.
+ * @return true on success.
+ */
+bool writeAssetArchive(const std::string &root, const std::vector<std::string> &names,
+                       const std::string &path, std::ostream &log);
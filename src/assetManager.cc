@@ -0,0 +1,217 @@
+#include "assetManager.hh"
+
+#include <filesystem>
+#include <iostream>
+#include <span>
+
+namespace
+{
+    struct AssetFile
+    {
+        const char *name;
+        const char *path; // relative to the assets directory
+    };
+
+    // Indexed by FontId / SoundId; paths double as archive entry names
+    constexpr AssetFile FONT_FILES[] = {
+        {"number", "fonts/Montserrat-Bold.ttf"},
+        {"title", "fonts/Poppins-Bold.ttf"},
+        {"info", "fonts/Nunito-Regular.ttf"},
+        {"button", "fonts/Quicksand-Bold.otf"}};
+
+    constexpr AssetFile SOUND_FILES[] = {
+        {"click", "musics/pick.wav"},
+        {"win", "musics/win.mp3"}};
+
+    constexpr AssetFile MUSIC_FILE = {"music", "musics/bg_music.mp3"};
+
+    // Built by the asset_pack target from exactly the files above (see PACKED_ASSETS in CMakeLists)
+    constexpr const char *ARCHIVE_FILE = "puzzle15.pak";
+
+    static_assert(std::size(FONT_FILES) == static_cast<std::size_t>(FontId::Count));
+    static_assert(std::size(SOUND_FILES) == static_cast<std::size_t>(SoundId::Count));
+
+    // Where one asset comes from: bytes inside the mapped archive, or a loose file
+    struct AssetSource
+    {
+        std::string path;
+        std::span<const unsigned char> bytes; // empty = load from path
+    };
+
+    // Run one load on the calling (worker) thread and time it
+    template <typename Load>
+    AssetTiming timedLoad(const AssetArchive &archive, const std::string &root, const AssetFile &file, Load load)
+    {
+        AssetTiming timing;
+        timing.name = file.name;
+
+        AssetSource source{root + file.path, archive.find(file.path)};
+        if (!source.bytes.empty())
+        {
+            timing.path = root + ARCHIVE_FILE + ":" + file.path;
+            timing.bytes = source.bytes.size();
+        }
+        else
+        {
+            timing.path = source.path;
+            std::error_code ec;
+            timing.bytes = std::filesystem::file_size(timing.path, ec);
+            if (ec)
+                timing.bytes = 0;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        timing.loaded = load(source);
+        timing.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return timing;
+    }
+}
+
+AssetManager::AssetManager(std::string root)
+    : m_root(std::move(root))
+{
+}
+
+AssetManager::~AssetManager()
+{
+    // Workers write into this object; never let them outlive it
+    for (auto &task : m_tasks)
+        if (task.valid())
+            task.wait();
+}
+
+/**
+ * Launch one loader task per asset.
+ *
+ * If the packed archive exists it is mapped once here and every asset is
+ * opened from memory (fonts and music stream straight from the mapping);
+ * otherwise the loose files are used. Every task writes only its own slot,
+ * so no locking is needed; wait() (through the futures) orders those writes
+ * before any read.
+ */
+void AssetManager::loadAsync()
+{
+    m_start = std::chrono::steady_clock::now();
+    m_archive.open(m_root + ARCHIVE_FILE);
+
+    for (std::size_t i = 0; i < std::size(FONT_FILES); ++i)
+        m_tasks.push_back(std::async(std::launch::async, [this, i]
+                                     {
+                                         AssetTiming timing = timedLoad(m_archive, m_root, FONT_FILES[i], [&](const AssetSource &source)
+                                                                        { return source.bytes.empty()
+                                                                                     ? m_fonts[i].openFromFile(source.path)
+                                                                                     : m_fonts[i].openFromMemory(source.bytes.data(), source.bytes.size()); });
+                                         if (timing.loaded)
+                                             prewarm(i, timing);
+                                         return timing; }));
+
+    for (std::size_t i = 0; i < std::size(SOUND_FILES); ++i)
+        m_tasks.push_back(std::async(std::launch::async, [this, i]
+                                     { return timedLoad(m_archive, m_root, SOUND_FILES[i], [&](const AssetSource &source)
+                                                        { return m_soundLoaded[i] = source.bytes.empty()
+                                                                                        ? m_sounds[i].loadFromFile(source.path)
+                                                                                        : m_sounds[i].loadFromMemory(source.bytes.data(), source.bytes.size()); }); }));
+
+    m_tasks.push_back(std::async(std::launch::async, [this]
+                                 { return timedLoad(m_archive, m_root, MUSIC_FILE, [&](const AssetSource &source)
+                                                    {
+                                                        m_musicLoaded = source.bytes.empty()
+                                                                            ? m_music.openFromFile(source.path)
+                                                                            : m_music.openFromMemory(source.bytes.data(), source.bytes.size());
+                                                        if (m_musicLoaded)
+                                                            m_music.setLooping(true); // repeat indefinitely
+                                                        return m_musicLoaded; }); }));
+}
+
+/**
+ * Register glyphs to rasterize on the font's loader thread.
+ *
+ * Glyphs are cached per character, size and boldness, so the set must
+ * match how the text is drawn (sf::Text::Bold on a regular font is a
+ * different glyph).
+ *
+ * @param id            Font the text uses.
+ * @param characters    Every character the text can show (ASCII).
+ * @param characterSize Character size the text is drawn at.
+ * @param bold          Whether the text has the sf::Text::Bold style.
+ */
+void AssetManager::prewarmGlyphs(FontId id, std::string_view characters, unsigned int characterSize, bool bold)
+{
+    m_glyphSets[static_cast<std::size_t>(id)].push_back({std::string(characters), characterSize, bold});
+}
+
+// Loader thread: rasterize the registered glyphs of a freshly opened font
+void AssetManager::prewarm(std::size_t font, AssetTiming &timing)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (const GlyphSet &set : m_glyphSets[font])
+        for (const char c : set.characters)
+        {
+            m_fonts[font].getGlyph(static_cast<unsigned char>(c), set.characterSize, set.bold);
+            ++timing.glyphs;
+        }
+    timing.glyphMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool AssetManager::ready() const
+{
+    for (const auto &task : m_tasks)
+        if (task.valid() && task.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
+    return true;
+}
+
+/**
+ * Join the loader tasks and collect their timings.
+ *
+ * Missing sounds or music are reported and skipped (the game runs silently);
+ * a missing font is fatal because every screen needs text.
+ *
+ * @return true if all fonts loaded.
+ */
+bool AssetManager::wait()
+{
+    if (m_tasks.empty())
+        return m_fontsLoaded;
+
+    for (auto &task : m_tasks)
+        m_timings.push_back(task.get());
+    m_tasks.clear();
+    m_wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+
+    m_fontsLoaded = true;
+    for (std::size_t i = 0; i < m_timings.size(); ++i)
+    {
+        const AssetTiming &timing = m_timings[i];
+        if (timing.loaded)
+            continue;
+
+        // Print error if the file cannot be found or decoded
+        std::cerr << "Asset " << timing.name << " not found at " << timing.path << "\n";
+        if (i < std::size(FONT_FILES))
+            m_fontsLoaded = false;
+    }
+    return m_fontsLoaded;
+}
+
+void AssetManager::report(std::ostream &out) const
+{
+    double work = 0.0;
+    for (const AssetTiming &timing : m_timings)
+        work += timing.milliseconds + timing.glyphMilliseconds;
+
+    out << "Assets loaded in " << m_wallMilliseconds << " ms (" << work << " ms of work on "
+        << m_timings.size() << " threads) from ";
+    if (m_archive.isOpen())
+        out << "one mapped archive of " << m_archive.size() / 1024.0 << " KB:\n";
+    else
+        out << "loose files:\n";
+    for (const AssetTiming &timing : m_timings)
+    {
+        out << "  " << timing.name << "\t" << timing.bytes / 1024.0 << " KB\t" << timing.milliseconds << " ms"
+            << (timing.loaded ? "" : "\tFAILED") << "\t" << timing.path;
+        if (timing.glyphs > 0)
+            out << "\t+ " << timing.glyphs << " glyphs prewarmed in " << timing.glyphMilliseconds << " ms";
+        out << "\n";
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "assetArchive.hh"
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Typed handles: each id indexes a fixed slot, so lookups are plain array accesses
+enum class FontId : std::uint8_t
+{
+    Number, // tile numbers
+    Title,  // title and win message
+    Info,   // right-side panel
+    Button, // buttons
+    Count
+};
+
+enum class SoundId : std::uint8_t
+{
+    Click, // tile moved
+    Win,   // puzzle solved
+    Count
+};
+
+// Load statistics of one asset
+struct AssetTiming
+{
+    std::string name;
+    std::string path;
+    std::uintmax_t bytes = 0;
+    double milliseconds = 0.0;
+    bool loaded = false;
+    std::size_t glyphs = 0;          // fonts: glyphs rasterized after loading
+    double glyphMilliseconds = 0.0;  // time spent on them
+};
+
+// Characters of one size and style to rasterize as soon as a font is loaded
+struct GlyphSet
+{
+    std::string characters;
+    unsigned int characterSize = 0;
+    bool bold = false;
+};
+
+/**
+ * Owns every font, sound buffer and the background music of the game.
+ *
+ * Assets come from the packed archive (puzzle15.pak, one memory mapping)
+ * when it exists, otherwise from the loose files under the assets directory.
+ *
+ * loadAsync() opens and decodes all assets in parallel on worker threads
+ * (one task per asset) so the window can be created and shown meanwhile;
+ * wait() joins them and records a per-asset timing breakdown. After that,
+ * font(FontId) and sound(SoundId) are O(1) array lookups suitable for the
+ * render loop.
+ *
+ * SFML rasterizes glyphs lazily, on the first draw of each character at
+ * each size; glyph sets registered with prewarmGlyphs() are rasterized
+ * (and uploaded to the font texture) by the font's loader task instead, so
+ * the first frame and the first win do not stall on FreeType.
+ */
+class AssetManager
+{
+public:
+    // root is the assets directory (e.g. resourcePath()), resolved once
+    explicit AssetManager(std::string root);
+    ~AssetManager();
+
+    AssetManager(const AssetManager &) = delete;
+    AssetManager &operator=(const AssetManager &) = delete;
+
+    // Rasterize these characters right after the font loads (call before loadAsync)
+    void prewarmGlyphs(FontId id, std::string_view characters, unsigned int characterSize, bool bold = false);
+
+    // Start loading every asset on worker threads; returns immediately
+    void loadAsync();
+
+    // True once every load task has finished (never blocks)
+    bool ready() const;
+
+    // Block until loading finished; false if a required asset (a font) failed
+    bool wait();
+
+    const sf::Font &font(FontId id) const { return m_fonts[static_cast<std::size_t>(id)]; }
+    const sf::SoundBuffer &sound(SoundId id) const { return m_sounds[static_cast<std::size_t>(id)]; }
+    bool hasSound(SoundId id) const { return m_soundLoaded[static_cast<std::size_t>(id)]; }
+
+    // Background music (opened for streaming and set to loop, not started)
+    sf::Music &music() { return m_music; }
+    bool hasMusic() const { return m_musicLoaded; }
+
+    // Per-asset load times plus wall time vs. summed work of the parallel load
+    void report(std::ostream &out) const;
+
+private:
+    void prewarm(std::size_t font, AssetTiming &timing);
+
+    std::string m_root;
+    AssetArchive m_archive; // must outlive the fonts and music streaming from it
+
+    std::array<sf::Font, static_cast<std::size_t>(FontId::Count)> m_fonts;
+    std::array<std::vector<GlyphSet>, static_cast<std::size_t>(FontId::Count)> m_glyphSets;
+    std::array<sf::SoundBuffer, static_cast<std::size_t>(SoundId::Count)> m_sounds;
+    std::array<bool, static_cast<std::size_t>(SoundId::Count)> m_soundLoaded{};
+    sf::Music m_music;
+    bool m_musicLoaded = false;
+
+    std::vector<std::future<AssetTiming>> m_tasks;
+    std::vector<AssetTiming> m_timings;
+    std::chrono::steady_clock::time_point m_start;
+    double m_wallMilliseconds = 0.0;
+    bool m_fontsLoaded = false;
+};
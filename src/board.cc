@@ -1,187 +1,235 @@
 #include "board.hh"
-#include "createShape.hh"
-#include <random>
+#include "packedBoard.hh"
+#include <algorithm>
+#include <cstdint>
 
-// Board size (4x4 puzzle)
-constexpr int N = 4;
+namespace
+{
+    // Compile-time neighbor table for an N x N board: up, left, right, down
+    template <int N>
+    struct NeighborTable
+    {
+        int count[N * N];
+        int target[N * N][4];
+        unsigned long long adjacent[N * N]; // bit j set if cell j is a neighbor (N*N <= 64)
+    };
 
-// Gap between tiles
-#if defined(__APPLE__)
-constexpr int gap = 20;
-#else
-constexpr int gap = 40;
-#endif
+    template <int N>
+    constexpr NeighborTable<N> makeNeighborTable()
+    {
+        NeighborTable<N> t{};
+        for (int i = 0; i < N * N; ++i)
+        {
+            const int x = i % N, y = i / N;
+            int n = 0;
+            auto add = [&](int cell)
+            {
+                t.target[i][n++] = cell;
+                t.adjacent[i] |= 1ull << cell;
+            };
+            if (y > 0)
+                add(i - N);
+            if (x > 0)
+                add(i - 1);
+            if (x < N - 1)
+                add(i + 1);
+            if (y < N - 1)
+                add(i + N);
+            t.count[i] = n;
+        }
+        return t;
+    }
 
-/**
- * Shuffle the puzzle board by performing random valid moves.
- *
- * This function simulates actual moves of the empty tile to ensure
- * the resulting board configuration is always solvable.
- *
- * @param board Reference to the puzzle board (array of 16 integers).
- *              Values 1–15 represent tiles, 0 represents the empty space.
- */
-void shuffleBoard(std::array<int, 16> &board)
-{
-    std::random_device rd;
-    std::mt19937 g(rd());
+    template <int N>
+    constexpr NeighborTable<N> NEIGHBORS = makeNeighborTable<N>();
 
-    int emptyPos = 15;             // Start with empty tile at last position
-    for (int i = 0; i < 1000; ++i) // Perform 1000 random moves
+    // Unbiased integer in [0, bound): multiply-shift on 32 random bits, rejecting the few biased products
+    inline int randomBelow(RandomEngine &rng, std::uint32_t bound)
     {
-        int ex = emptyPos % N, ey = emptyPos / N;
-        std::vector<int> validMoves;
-
-        // Collect valid neighbor positions
-        if (ex > 0)
-            validMoves.push_back(emptyPos - 1); // left
-        if (ex < N - 1)
-            validMoves.push_back(emptyPos + 1); // right
-        if (ey > 0)
-            validMoves.push_back(emptyPos - N); // up
-        if (ey < N - 1)
-            validMoves.push_back(emptyPos + N); // down
-
-        // Pick a random valid move
-        std::uniform_int_distribution<> dis(0, validMoves.size() - 1);
-        int newPos = validMoves[dis(g)];
-
-        // Swap empty tile with chosen neighbor
-        std::swap(board[emptyPos], board[newPos]);
-        emptyPos = newPos;
+        std::uint64_t product = static_cast<std::uint32_t>(rng()) * static_cast<std::uint64_t>(bound);
+        if (static_cast<std::uint32_t>(product) < bound)
+        {
+            const std::uint32_t threshold = (0u - bound) % bound;
+            while (static_cast<std::uint32_t>(product) < threshold)
+                product = static_cast<std::uint32_t>(rng()) * static_cast<std::uint64_t>(bound);
+        }
+        return static_cast<int>(product >> 32);
     }
 }
 
 /**
- * Draw the puzzle board with tiles and numbers.
+ * Draw a uniformly random solvable position.
  *
- * Each tile is drawn as a rounded rectangle with a color depending on its state:
- *  - Purple for the empty tile
- *  - Orange for tiles in the correct position
- *  - Teal for tiles in the wrong position
+ * Fisher-Yates shuffles all N*N cells (blank included) while tracking the
+ * parity of the permutation: every swap of two distinct cells flips it. A
+ * position is reachable from the goal exactly when that parity matches the
+ * parity of the blank's Manhattan distance to its goal cell, since every
+ * move is one transposition that moves the blank by one cell. Unsolvable
+ * draws swap two fixed non-blank tiles, which maps them one-to-one onto
+ * solvable positions with the same blank cell, so the result stays uniform.
  *
- * @param window       Render target window.
- * @param board        Current puzzle board state.
- * @param fontNumber   Font used for drawing numbers.
- * @param margin       Horizontal margin around the puzzle.
- * @param headerHeight Vertical space reserved for header.
- * @param topMargin    Extra margin above the puzzle grid.
- * @param rectSize     Size of each tile rectangle.
- * @param cornerRadius Radius for rounded corners.
+ * O(N*N) random draws and swaps on the board itself; no allocation.
+ *
+ * @param board Reference to the puzzle board.
+ * @param rng   Random engine, reused across calls.
  */
-void drawBoard(sf::RenderWindow &window,
-               const std::array<int, 16> &board,
-               const sf::Font &fontNumber,
-               float margin, float headerHeight, float topMargin,
-               float rectSize, float cornerRadius, unsigned int fontSize)
+template <int N>
+void shuffleBoard(Board<N> &board, RandomEngine &rng)
 {
-    for (int i = 0; i < 16; ++i)
+    do
     {
-        int val = board[i]; // Tile value (0 = empty)
-        int xIndex = i % N; // Column index
-        int yIndex = i / N; // Row index
-
-        float offsetX = margin;
-        float offsetY = headerHeight + topMargin;
-
-        // Calculate tile position
-        float x = xIndex * (rectSize + gap) + offsetX;
-        float y = yIndex * (rectSize + gap) + offsetY;
-
-        // Create rounded rectangle tile
-        sf::ConvexShape rect = createRoundedRect(rectSize, rectSize, cornerRadius);
-        rect.setPosition({x, y});
-
-        // Color based on tile state
-        if (val == 0)
-            rect.setFillColor(sf::Color(128, 0, 128)); // Empty tile (purple)
-        else if (val == i + 1)
-            rect.setFillColor(sf::Color(255, 165, 0)); // Correct position (orange)
-        else
-            rect.setFillColor(sf::Color(60, 180, 170)); // Wrong position (teal)
-
-        rect.setOutlineThickness(1);
-        rect.setOutlineColor(sf::Color::Black);
-        window.draw(rect);
-
-        // Draw number if not empty
-        if (val)
+        board = Board<N>{};
+        auto &tiles = board.tiles;
+        int emptyPos = N * N - 1;
+        bool oddPermutation = false;
+
+        for (int i = N * N - 1; i > 0; --i)
         {
-            sf::Text text(fontNumber, std::to_string(val), fontSize);
-            text.setFillColor(sf::Color::White);
-            centerText(text, x, y, rectSize, rectSize);
-            window.draw(text);
+            const int j = randomBelow(rng, static_cast<std::uint32_t>(i + 1));
+            if (j == i)
+                continue;
+
+            // Follow the blank so it does not have to be searched for afterwards
+            if (tiles[j] == 0)
+                emptyPos = i;
+            else if (tiles[i] == 0)
+                emptyPos = j;
+            std::swap(tiles[i], tiles[j]);
+            oddPermutation = !oddPermutation;
         }
-    }
+
+        const int blankDistance = (N - 1 - emptyPos % N) + (N - 1 - emptyPos / N);
+        if (oddPermutation != (blankDistance % 2 == 1))
+        {
+            // First two cells that do not hold the blank
+            const int a = emptyPos == 0 ? 1 : 0;
+            const int b = emptyPos <= 1 ? 2 : 1;
+            std::swap(tiles[a], tiles[b]);
+        }
+        board.emptyIdx = emptyPos;
+    } while (isSolved(board)); // a fresh game never starts already won
 }
 
 /**
- * Attempt to move a tile into the empty space if adjacent.
+ * Slide a tile into the empty space if adjacent.
  *
- * Updates the board state, increments move count, plays click sound,
- * and checks for win condition. If solved, updates game state and plays win sound.
- *
- * @param board        Puzzle board state.
- * @param emptyIdx     Index of the empty tile (updated if move succeeds).
- * @param targetX      Target tile column index.
- * @param targetY      Target tile row index.
- * @param moveCount    Reference to move counter.
- * @param clickSound   Sound effect played on tile move.
- * @param music        Background music (paused on win).
- * @param winSound     Sound effect played on win.
- * @param gameClock    Clock tracking elapsed time.
- * @param gameWon      Flag set to true if puzzle is solved.
- * @param finalTime    Time taken to solve puzzle.
- * @param winShownTime Timestamp when win was achieved.
+ * @param board   Puzzle board state.
+ * @param targetX Target tile column index.
+ * @param targetY Target tile row index.
+ * @return true if the tile moved.
  */
-void tryMoveTile(std::array<int, 16> &board,
-                 int &emptyIdx, int targetX, int targetY,
-                 int &moveCount,
-                 std::unique_ptr<sf::Sound> &clickSound,
-                 sf::Music &music, std::unique_ptr<sf::Sound> &winSound,
-                 sf::Clock &gameClock, bool &gameWon,
-                 int &finalTime, sf::Time &winShownTime)
+template <int N>
+bool moveTile(Board<N> &board, int targetX, int targetY)
 {
-    int ex = emptyIdx % N; // Empty tile column
-    int ey = emptyIdx / N; // Empty tile row
-
-    // Check adjacency (Manhattan distance = 1)
-    if ((abs(ex - targetX) + abs(ey - targetY)) == 1)
-    {
-        int idx = targetY * N + targetX;
-        std::swap(board[idx], board[emptyIdx]);
-        emptyIdx = idx;
-        moveCount++;
+    if (targetX < 0 || targetX >= N || targetY < 0 || targetY >= N)
+        return false;
 
-        if (clickSound)
-            clickSound->play();
+    // Check adjacency (Manhattan distance = 1) with the precomputed neighbor mask
+    int idx = targetY * N + targetX;
+    if (!((NEIGHBORS<N>.adjacent[board.emptyIdx] >> idx) & 1ull))
+        return false;
 
-        // Check if puzzle is solved
-        if (isSolved(board))
-        {
-            gameWon = true;
-            finalTime = static_cast<int>(gameClock.getElapsedTime().asSeconds());
-            winSound->play();
-            music.pause();
-            winShownTime = gameClock.getElapsedTime();
-        }
-    }
+    std::swap(board.tiles[idx], board.tiles[board.emptyIdx]);
+    board.emptyIdx = idx;
+    return true;
 }
 
 /**
  * Check if the puzzle board is solved.
  *
- * The solved state requires tiles 1–15 to be in ascending order
- * and the last tile (index 15) to be empty (0).
+ * The solved state requires tiles 1..N*N-1 to be in ascending order
+ * and the last tile to be empty (0).
  *
  * @param board Puzzle board state.
  * @return true if solved, false otherwise.
  */
-bool isSolved(const std::array<int, 16> &board)
+template <int N>
+bool isSolved(const Board<N> &board)
 {
-    for (auto a{0}; a < 15; ++a)
-        if (board[a] != a + 1)
-            return false;
+    if constexpr (N == 4)
+        return packBoard(board.tiles) == PACKED_SOLVED; // Single compare against the packed goal
+    else
+        return board.tiles == Board<N>::solvedTiles();
+}
 
-    return board[15] == 0; // Last tile must be empty
+// Explicit instantiations for every supported board size
+#define INSTANTIATE_BOARD(N)                                                 \
+    template void shuffleBoard<N>(Board<N> &, RandomEngine &); \
+    template bool moveTile<N>(Board<N> &, int, int);           \
+    template bool isSolved<N>(const Board<N> &);
+
+INSTANTIATE_BOARD(3)
+INSTANTIATE_BOARD(4)
+INSTANTIATE_BOARD(5)
+INSTANTIATE_BOARD(6)
+INSTANTIATE_BOARD(7)
+INSTANTIATE_BOARD(8)
+#undef INSTANTIATE_BOARD
+
+// Build a solved board of the requested size
+void PuzzleBoard::reset(int size)
+{
+    switch (std::clamp(size, MIN_BOARD_SIZE, MAX_BOARD_SIZE))
+    {
+    case 3:
+        m_board = Board<3>{};
+        break;
+    case 5:
+        m_board = Board<5>{};
+        break;
+    case 6:
+        m_board = Board<6>{};
+        break;
+    case 7:
+        m_board = Board<7>{};
+        break;
+    case 8:
+        m_board = Board<8>{};
+        break;
+    default:
+        m_board = Board<4>{};
+        break;
+    }
+}
+
+int PuzzleBoard::size() const
+{
+    return std::visit([](const auto &b)
+                      { return b.SIZE; }, m_board);
+}
+
+int PuzzleBoard::emptyIdx() const
+{
+    return std::visit([](const auto &b)
+                      { return b.emptyIdx; }, m_board);
+}
+
+int PuzzleBoard::tile(int index) const
+{
+    return std::visit([index](const auto &b)
+                      { return b.tiles[index]; }, m_board);
+}
+
+std::span<const int> PuzzleBoard::tiles() const
+{
+    return std::visit([](const auto &b)
+                      { return std::span<const int>(b.tiles); }, m_board);
+}
+
+void PuzzleBoard::shuffle(RandomEngine &rng)
+{
+    std::visit([&rng](auto &b)
+               { shuffleBoard(b, rng); }, m_board);
+}
+
+bool PuzzleBoard::moveTile(int targetX, int targetY)
+{
+    return std::visit([=](auto &b)
+                      { return ::moveTile(b, targetX, targetY); }, m_board);
+}
+
+bool PuzzleBoard::isSolved() const
+{
+    return std::visit([](const auto &b)
+                      { return ::isSolved(b); }, m_board);
 }
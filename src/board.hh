@@ -1,95 +1,116 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
-
-#include <memory>
 #include <array>
+#include <random>
+#include <span>
+#include <variant>
+
+// Supported board sizes: 3x3 (8-puzzle) up to 8x8 (63-puzzle)
+constexpr int MIN_BOARD_SIZE = 3;
+constexpr int MAX_BOARD_SIZE = 8;
+constexpr int DEFAULT_BOARD_SIZE = 4; // classic 15 puzzle; the window layout is sized for it
 
-extern const int N;
+// Random engine behind shuffles; seed it to make games reproducible
+using RandomEngine = std::mt19937_64;
 
 /**
- * Shuffle the puzzle board by performing random valid moves.
- *
- * This function simulates moves of the empty tile (value 0) to produce
- * a randomized yet solvable configuration. It modifies the input board in place.
+ * Puzzle board of compile-time size N x N.
  *
- * @param board Puzzle board array (size 16). Values 1–15 are tiles; 0 is the empty space.
+ * tiles holds values 1..N*N-1 in row-major order with 0 for the empty space;
+ * emptyIdx caches the index of the 0. Because N is a template parameter,
+ * every loop over the board has a constant trip count and all index math
+ * (% N, / N, neighbor lookups) folds into constants or small tables.
  */
-void shuffleBoard(std::array<int, 16> &);
+template <int N>
+struct Board
+{
+    static_assert(N >= MIN_BOARD_SIZE && N <= MAX_BOARD_SIZE, "unsupported board size");
+
+    static constexpr int SIZE = N;
+    static constexpr int CELLS = N * N;
+
+    std::array<int, N * N> tiles = solvedTiles();
+    int emptyIdx = N * N - 1;
+
+    // Goal configuration: 1..N*N-1 followed by the empty tile
+    static constexpr std::array<int, N * N> solvedTiles()
+    {
+        std::array<int, N * N> t{};
+        for (int i = 0; i < N * N - 1; ++i)
+            t[i] = i + 1;
+        return t;
+    }
+};
 
 /**
- * Render the puzzle grid and its tiles onto the target window.
- *
- * Each tile is drawn as a rounded rectangle. Colors indicate state:
- *  - Empty tile (0): purple
- *  - Correctly placed tile: orange
- *  - Misplaced tile: teal
- * The tile number is centered inside non-empty tiles using fontNumber.
+ * Replace the board with a uniformly random solvable position.
  *
- * Layout:
- *  - Grid size is determined by global N (e.g., 4x4).
- *  - Tile position = (index * (rectSize + gap)) + corresponding offset.
- *  - Offsets: margin (X), headerHeight + topMargin (Y).
+ * Every solvable configuration other than the goal is equally likely
+ * (Fisher-Yates plus a parity fix-up, no allocation), unlike a random walk
+ * that stays biased towards positions near the goal.
  *
- * @param window       Render target window.
- * @param board        Current board state (read-only).
- * @param fontNumber   Font used to draw tile numbers.
- * @param margin       Horizontal offset from the left of the window to the grid.
- * @param headerHeight Vertical space reserved for the title/header above the grid.
- * @param topMargin    Extra top padding below the header.
- * @param rectSize     Tile width/height (square).
- * @param cornerRadius Corner radius for rounded tile rectangles.
- * @param fontSize     Font size for tile numbers.
+ * @param board Puzzle board, reset to the goal and then shuffled.
+ * @param rng   Random engine (the same seed gives the same board).
  */
-void drawBoard(sf::RenderWindow &window,
-               const std::array<int, 16> &board,
-               const sf::Font &fontNumber,
-               float margin, float headerHeight, float topMargin,
-               float rectSize, float cornerRadius,
-               unsigned int fontSize);
+template <int N>
+void shuffleBoard(Board<N> &board, RandomEngine &rng);
 
 /**
- * Attempt to move a tile into the empty space if it is adjacent.
- *
- * Behavior:
- *  - Valid move: Manhattan distance between target tile and empty tile == 1.
- *  - On success: swaps tiles, updates emptyIdx and moveCount, plays clickSound.
- *  - Win check: if the board is solved, sets gameWon, records finalTime,
- *               pauses background music and plays winSound, stores winShownTime.
+ * Slide the tile at (targetX, targetY) into the empty space if it is adjacent.
  *
- * Notes:
- *  - Sounds are passed as unique_ptr to align with ownership in the main module.
- *  - Time values are based on gameClock (seconds).
+ * Pure board logic (no sound or clock side effects).
  *
- * @param board         Puzzle board (modified in place).
- * @param emptyIdx      Index of the empty tile in the board (updated on move).
- * @param targetX       Column of the tile to move (0-based).
- * @param targetY       Row of the tile to move (0-based).
- * @param moveCount     Reference to the total number of successful moves (incremented).
- * @param clickSound    Sound effect to play on a successful tile move.
- * @param music         Background music (paused when the player wins).
- * @param winSound      Sound effect to play when the puzzle is solved.
- * @param gameClock     Clock used to compute elapsed time and win timestamp.
- * @param gameWon       Flag set to true when the puzzle is solved.
- * @param finalTime     Elapsed time in seconds at the moment of victory.
- * @param winShownTime  Timestamp (sf::Time) when the win screen was triggered.
+ * @param board   Puzzle board (modified in place).
+ * @param targetX Column of the tile to move (0-based).
+ * @param targetY Row of the tile to move (0-based).
+ * @return true if the tile moved.
  */
-void tryMoveTile(std::array<int, 16> &board,
-                 int &emptyIdx, int targetX, int targetY,
-                 int &moveCount,
-                 std::unique_ptr<sf::Sound> &clickSound,
-                 sf::Music &music, std::unique_ptr<sf::Sound> &winSound,
-                 sf::Clock &gameClock, bool &gameWon,
-                 int &finalTime, sf::Time &winShownTime);
+template <int N>
+bool moveTile(Board<N> &board, int targetX, int targetY);
 
 /**
  * Determine whether the board is in the solved state.
  *
- * A solved board has tiles 1–15 in ascending order and the last slot (index 15)
+ * A solved board has tiles 1..N*N-1 in ascending order and the last slot
  * is the empty tile (0).
  *
  * @param board Current board state.
  * @return true if solved; false otherwise.
  */
-bool isSolved(const std::array<int, 16> &board);
+template <int N>
+bool isSolved(const Board<N> &board);
+
+/**
+ * Board whose size is chosen at runtime (e.g. by the player).
+ *
+ * Holds one of Board<3> ... Board<8>; every operation dispatches once
+ * through std::visit into the fully specialized implementation for that
+ * size, so there is no generic slow path. Pure logic: no SFML dependency.
+ */
+class PuzzleBoard
+{
+public:
+    using Variant = std::variant<Board<3>, Board<4>, Board<5>, Board<6>, Board<7>, Board<8>>;
+
+    explicit PuzzleBoard(int size = DEFAULT_BOARD_SIZE) { reset(size); }
+
+    // Switch to a solved board of the given size (clamped to the supported range)
+    void reset(int size);
+
+    int size() const;
+    int cellCount() const { return size() * size(); }
+    int emptyIdx() const;
+    int tile(int index) const;
+    std::span<const int> tiles() const;
+
+    void shuffle(RandomEngine &rng);
+    bool moveTile(int targetX, int targetY);
+    bool isSolved() const;
+
+    // Direct access for size-specific code (solver, renderer)
+    const Variant &variant() const { return m_board; }
+
+private:
+    Variant m_board;
+};
+
@@ -0,0 +1,408 @@
+#include "boardRenderer.hh"
+#include "createShape.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+#include <string>
+
+// Gap between tiles of the default 4x4 grid (scaled down for larger boards)
+#if defined(__APPLE__)
+constexpr int gap = 20;
+#else
+constexpr int gap = 40;
+#endif
+
+namespace
+{
+    // Same outline as createRoundedRect() with its default 8 segments per corner
+    constexpr int CORNER_SEGMENTS = 8;
+    constexpr int OUTLINE_POINTS = (CORNER_SEGMENTS + 1) * 4;
+    constexpr int FAN_VERTICES = OUTLINE_POINTS * 3;  // one triangle per outline edge
+    constexpr int TILE_VERTICES = FAN_VERTICES * 2;   // black border fan + colored fill fan
+    constexpr float OUTLINE_THICKNESS = 1.f;
+    constexpr float HIGHLIGHT_THICKNESS = 8.f;
+
+    const sf::Color EMPTY_COLOR(128, 0, 128);   // purple
+    const sf::Color CORRECT_COLOR(255, 165, 0); // orange
+    const sf::Color WRONG_COLOR(60, 180, 170);  // teal
+    const sf::Color HIGHLIGHT_COLOR(255, 230, 0); // hinted tile outline
+
+    // Unit direction of each outline point from its corner's arc center, plus
+    // which side of the tile that arc center is on (0 = left/top, 1 = right/bottom)
+    struct CornerPoint
+    {
+        sf::Vector2f direction;
+        float right, bottom;
+    };
+
+    // The only trigonometry in the renderer; evaluated once per process
+    const std::array<CornerPoint, OUTLINE_POINTS> &cornerTable()
+    {
+        static const std::array<CornerPoint, OUTLINE_POINTS> table = []
+        {
+            std::array<CornerPoint, OUTLINE_POINTS> t{};
+            constexpr float startAngle[4] = {180.f, 270.f, 0.f, 90.f}; // top-left, top-right, bottom-right, bottom-left
+            constexpr float right[4] = {0.f, 1.f, 1.f, 0.f};
+            constexpr float bottom[4] = {0.f, 0.f, 1.f, 1.f};
+            int n = 0;
+            for (int corner = 0; corner < 4; ++corner)
+                for (int i = 0; i <= CORNER_SEGMENTS; ++i)
+                {
+                    float rad = (startAngle[corner] + i * 90.f / CORNER_SEGMENTS) * std::numbers::pi_v<float> / 180.f;
+                    t[n++] = {{std::cos(rad), std::sin(rad)}, right[corner], bottom[corner]};
+                }
+            return t;
+        }();
+        return table;
+    }
+
+    sf::Color tileColor(int value, int cell)
+    {
+        if (value == 0)
+            return EMPTY_COLOR;
+        return value == cell + 1 ? CORRECT_COLOR : WRONG_COLOR;
+    }
+
+    // Write a rounded square as a triangle fan around its center; `grow` expands it outward
+    void writeFan(sf::Vertex *out, float x, float y, float size, float radius, float grow, sf::Color color)
+    {
+        const auto &table = cornerTable();
+        const sf::Vector2f center{x + size / 2.f, y + size / 2.f};
+        const float arcRadius = radius + grow;
+
+        auto point = [&](int k)
+        {
+            const CornerPoint &c = table[k];
+            return sf::Vector2f{x + (c.right ? size - radius : radius) + arcRadius * c.direction.x,
+                                y + (c.bottom ? size - radius : radius) + arcRadius * c.direction.y};
+        };
+
+        sf::Vector2f first = point(0), previous = first;
+        for (int k = 0; k < OUTLINE_POINTS; ++k)
+        {
+            sf::Vector2f next = k + 1 < OUTLINE_POINTS ? point(k + 1) : first;
+            *out++ = {center, color};
+            *out++ = {previous, color};
+            *out++ = {next, color};
+            previous = next;
+        }
+    }
+}
+
+float boardTileGap(int size)
+{
+    return static_cast<float>(gap) * DEFAULT_BOARD_SIZE / size;
+}
+
+/**
+ * Draw the puzzle board with tiles and numbers.
+ *
+ * Each tile is drawn as a rounded rectangle with a color depending on its state:
+ *  - Purple for the empty tile
+ *  - Orange for tiles in the correct position
+ *  - Teal for tiles in the wrong position
+ *
+ * @param target       Render target (window or offscreen texture).
+ * @param board        Current puzzle board state.
+ * @param fontNumber   Font used for drawing numbers.
+ * @param margin       Horizontal margin around the puzzle.
+ * @param headerHeight Vertical space reserved for header.
+ * @param topMargin    Extra margin above the puzzle grid.
+ * @param rectSize     Size of each tile rectangle.
+ * @param cornerRadius Radius for rounded corners.
+ */
+void drawBoard(sf::RenderTarget &target,
+               const PuzzleBoard &board,
+               const sf::Font &fontNumber,
+               float margin, float headerHeight, float topMargin,
+               float rectSize, float cornerRadius, unsigned int fontSize)
+{
+    const int n = board.size();
+    const float tileGap = boardTileGap(n);
+    const std::span<const int> tiles = board.tiles();
+
+    for (int i = 0; i < n * n; ++i)
+    {
+        int val = tiles[i]; // Tile value (0 = empty)
+        int xIndex = i % n; // Column index
+        int yIndex = i / n; // Row index
+
+        float offsetX = margin;
+        float offsetY = headerHeight + topMargin;
+
+        // Calculate tile position
+        float x = xIndex * (rectSize + tileGap) + offsetX;
+        float y = yIndex * (rectSize + tileGap) + offsetY;
+
+        // Create rounded rectangle tile
+        sf::ConvexShape rect = createRoundedRect(rectSize, rectSize, cornerRadius);
+        rect.setPosition({x, y});
+
+        // Color based on tile state
+        rect.setFillColor(tileColor(val, i));
+        rect.setOutlineThickness(1);
+        rect.setOutlineColor(sf::Color::Black);
+        target.draw(rect);
+
+        // Draw number if not empty
+        if (val)
+        {
+            sf::Text text(fontNumber, std::to_string(val), fontSize);
+            text.setFillColor(sf::Color::White);
+            centerText(text, x, y, rectSize, rectSize);
+            target.draw(text);
+        }
+    }
+}
+
+BoardRenderer::BoardRenderer(const sf::Font &fontNumber)
+    : m_font(fontNumber)
+{
+}
+
+/**
+ * Build the tile geometry and glyph quads for a layout.
+ *
+ * This is the only place that allocates; the vertex arrays keep their size
+ * until the layout (board size or scale) changes again.
+ *
+ * @param size         Board dimension.
+ * @param originX      X of the top-left tile.
+ * @param originY      Y of the top-left tile.
+ * @param rectSize     Tile width/height.
+ * @param cornerRadius Corner radius of the tiles.
+ * @param fontSize     Character size of the numbers.
+ */
+void BoardRenderer::setLayout(int size, float originX, float originY,
+                              float rectSize, float cornerRadius, unsigned int fontSize)
+{
+    m_size = size;
+    m_originX = originX;
+    m_originY = originY;
+    m_rectSize = rectSize;
+    m_cornerRadius = cornerRadius;
+    m_pitch = rectSize + boardTileGap(size);
+    m_fontSize = fontSize;
+
+    const int cells = size * size;
+    m_tiles.resize(static_cast<std::size_t>(cells) * TILE_VERTICES);
+    m_glyphs.resize(static_cast<std::size_t>(cells) * GLYPH_VERTICES);
+    m_shown.assign(cells, -1);
+    m_highlight = -1;
+    buildNumbers(cells);
+
+    // Borders only change with the highlight, so they are written once here
+    for (int cell = 0; cell < cells; ++cell)
+        writeBorder(cell, false);
+}
+
+// Border fan of one tile: thin black outline, or the thick highlight
+void BoardRenderer::writeBorder(int cell, bool highlighted)
+{
+    const float x = m_originX + (cell % m_size) * m_pitch;
+    const float y = m_originY + (cell / m_size) * m_pitch;
+    writeFan(&m_tiles[static_cast<std::size_t>(cell) * TILE_VERTICES], x, y, m_rectSize, m_cornerRadius,
+             highlighted ? HIGHLIGHT_THICKNESS : OUTLINE_THICKNESS, highlighted ? HIGHLIGHT_COLOR : sf::Color::Black);
+}
+
+void BoardRenderer::setHighlight(int cell)
+{
+    if (cell >= m_size * m_size)
+        cell = -1;
+    if (cell == m_highlight)
+        return;
+
+    if (m_highlight >= 0)
+        writeBorder(m_highlight, false);
+    if (cell >= 0)
+        writeBorder(cell, true);
+    m_highlight = cell;
+}
+
+/**
+ * Lay out the numbers 1..cellCount-1 once, centered on the origin.
+ *
+ * Mirrors sf::Text: glyphs advance with kerning, quads carry one pixel of
+ * padding, and the string's bounds are centered the same way centerText() does.
+ *
+ * @param cellCount Number of cells on the board.
+ */
+void BoardRenderer::buildNumbers(int cellCount)
+{
+    constexpr float padding = 1.f;
+
+    m_numbers.assign(cellCount, NumberQuads{});
+    for (int value = 1; value < cellCount; ++value)
+    {
+        const std::string digits = std::to_string(value);
+        NumberQuads &quads = m_numbers[value];
+
+        float pen = 0.f;
+        float minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+        char32_t previous = 0;
+        for (std::size_t i = 0; i < digits.size(); ++i)
+        {
+            const char32_t c = static_cast<char32_t>(digits[i]);
+            if (previous)
+                pen += m_font.getKerning(previous, c, m_fontSize);
+            previous = c;
+
+            const sf::Glyph &glyph = m_font.getGlyph(c, m_fontSize, false);
+            const float left = pen + glyph.bounds.position.x;
+            const float top = glyph.bounds.position.y;
+            const float right = left + glyph.bounds.size.x;
+            const float bottom = top + glyph.bounds.size.y;
+            if (i == 0)
+            {
+                minX = left, minY = top, maxX = right, maxY = bottom;
+            }
+            else
+            {
+                minX = std::min(minX, left), minY = std::min(minY, top);
+                maxX = std::max(maxX, right), maxY = std::max(maxY, bottom);
+            }
+
+            const float u1 = static_cast<float>(glyph.textureRect.position.x) - padding;
+            const float v1 = static_cast<float>(glyph.textureRect.position.y) - padding;
+            const float u2 = static_cast<float>(glyph.textureRect.position.x + glyph.textureRect.size.x) + padding;
+            const float v2 = static_cast<float>(glyph.textureRect.position.y + glyph.textureRect.size.y) + padding;
+
+            sf::Vertex *q = &quads[i * 6];
+            q[0] = {{left - padding, top - padding}, sf::Color::White, {u1, v1}};
+            q[1] = {{right + padding, top - padding}, sf::Color::White, {u2, v1}};
+            q[2] = {{left - padding, bottom + padding}, sf::Color::White, {u1, v2}};
+            q[3] = q[2];
+            q[4] = q[1];
+            q[5] = {{right + padding, bottom + padding}, sf::Color::White, {u2, v2}};
+
+            pen += glyph.advance;
+        }
+
+        // Center the string's bounds on (0, 0); unused slots stay degenerate
+        const sf::Vector2f center{(minX + maxX) / 2.f, (minY + maxY) / 2.f};
+        for (std::size_t v = 0; v < digits.size() * 6; ++v)
+            quads[v].position -= center;
+    }
+}
+
+// Recolor one tile's fill and swap in the glyph quads of its new value
+void BoardRenderer::writeTile(int cell, int value)
+{
+    const float x = m_originX + (cell % m_size) * m_pitch;
+    const float y = m_originY + (cell / m_size) * m_pitch;
+
+    writeFan(&m_tiles[static_cast<std::size_t>(cell) * TILE_VERTICES + FAN_VERTICES], x, y, m_rectSize,
+             m_cornerRadius, 0.f, tileColor(value, cell));
+
+    const sf::Vector2f center{x + m_rectSize / 2.f, y + m_rectSize / 2.f};
+    sf::Vertex *out = &m_glyphs[static_cast<std::size_t>(cell) * GLYPH_VERTICES];
+    const NumberQuads &quads = m_numbers[value];
+    for (int v = 0; v < GLYPH_VERTICES; ++v)
+    {
+        out[v] = quads[v];
+        out[v].position += center;
+    }
+}
+
+int BoardRenderer::update(const PuzzleBoard &board)
+{
+    const std::span<const int> tiles = board.tiles();
+    if (board.size() != m_size)
+        return 0;
+
+    int patched = 0;
+    for (int cell = 0; cell < static_cast<int>(tiles.size()); ++cell)
+    {
+        if (tiles[cell] == m_shown[cell])
+            continue;
+        writeTile(cell, tiles[cell]);
+        m_shown[cell] = tiles[cell];
+        ++patched;
+    }
+    return patched;
+}
+
+void BoardRenderer::draw(sf::RenderTarget &target) const
+{
+    target.draw(m_tiles);
+
+    sf::RenderStates states;
+    states.texture = &m_font.getTexture(m_fontSize);
+    target.draw(m_glyphs, states);
+}
+
+/**
+ * Render identical frames through both board paths and time them.
+ *
+ * @return Comparison of frame time, draw calls and output pixels.
+ */
+RenderComparison compareBoardRendering(const PuzzleBoard &board, const sf::Font &fontNumber,
+                                       sf::Vector2u targetSize,
+                                       float margin, float headerHeight, float topMargin,
+                                       float rectSize, float cornerRadius,
+                                       unsigned int fontSize, int frames)
+{
+    RenderComparison result;
+    sf::RenderTexture texture;
+    if (frames <= 0 || !texture.resize(targetSize))
+        return result;
+
+    const int n = board.size();
+    const int emptyX = board.emptyIdx() % n;
+    const int emptyY = board.emptyIdx() / n;
+    const int slideX = emptyX > 0 ? emptyX - 1 : emptyX + 1;
+
+    // Runs `frames` frames of one path; the board slides one tile back and forth
+    auto run = [&](auto &&drawFrame)
+    {
+        PuzzleBoard frameBoard = board;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            if (frame % 2)
+                frameBoard.moveTile(emptyX, emptyY);
+            else
+                frameBoard.moveTile(slideX, emptyY);
+
+            texture.clear(sf::Color(180, 140, 200));
+            drawFrame(frameBoard);
+            texture.display();
+        }
+        sf::Image image = texture.getTexture().copyToImage(); // waits for the GPU to finish
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(ms / frames, std::move(image));
+    };
+
+    auto [legacyMs, legacyImage] = run([&](const PuzzleBoard &b)
+                                       { drawBoard(texture, b, fontNumber, margin, headerHeight, topMargin,
+                                                   rectSize, cornerRadius, fontSize); });
+
+    BoardRenderer renderer(fontNumber);
+    renderer.setLayout(n, margin, headerHeight + topMargin, rectSize, cornerRadius, fontSize);
+    auto [batchedMs, batchedImage] = run([&](const PuzzleBoard &b)
+                                         {
+                                             renderer.update(b);
+                                             renderer.draw(texture); });
+
+    result.frames = frames;
+    result.legacyMs = legacyMs;
+    result.batchedMs = batchedMs;
+    result.legacyDrawCalls = board.cellCount() * 2 - 1; // a shape per tile, a text per number
+    result.batchedDrawCalls = BoardRenderer::DRAW_CALLS;
+
+    // Anti-aliasing may differ slightly at tile borders; count only visible differences
+    const sf::Vector2u imageSize = legacyImage.getSize();
+    for (unsigned y = 0; y < imageSize.y; ++y)
+        for (unsigned x = 0; x < imageSize.x; ++x)
+        {
+            sf::Color a = legacyImage.getPixel({x, y});
+            sf::Color b = batchedImage.getPixel({x, y});
+            int delta = std::max({std::abs(a.r - b.r), std::abs(a.g - b.g), std::abs(a.b - b.b)});
+            if (delta > 32)
+                ++result.differingPixels;
+        }
+    return result;
+}
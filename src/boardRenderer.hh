@@ -0,0 +1,154 @@
+#pragma once
+
+#include "board.hh"
+
+#include <SFML/Graphics.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Gap between tiles of an N x N grid (the 4x4 gap scaled so every size fills the same area)
+float boardTileGap(int size);
+
+/**
+ * Render the puzzle grid and its tiles onto the target, one shape and one text per tile.
+ *
+ * Immediate-mode reference path (kept for comparison with BoardRenderer).
+ * Each tile is drawn as a rounded rectangle. Colors indicate state:
+ *  - Empty tile (0): purple
+ *  - Correctly placed tile: orange
+ *  - Misplaced tile: teal
+ * The tile number is centered inside non-empty tiles using fontNumber.
+ *
+ * Layout:
+ *  - Grid size is N x N; the gap between tiles shrinks with N so every
+ *    size fills the area of the default 4x4 grid.
+ *  - Tile position = (index * (rectSize + gap)) + corresponding offset.
+ *  - Offsets: margin (X), headerHeight + topMargin (Y).
+ *
+ * @param target       Render target (window or offscreen texture).
+ * @param board        Current board state (read-only).
+ * @param fontNumber   Font used to draw tile numbers.
+ * @param margin       Horizontal offset from the left of the window to the grid.
+ * @param headerHeight Vertical space reserved for the title/header above the grid.
+ * @param topMargin    Extra top padding below the header.
+ * @param rectSize     Tile width/height (square).
+ * @param cornerRadius Corner radius for rounded tile rectangles.
+ * @param fontSize     Font size for tile numbers.
+ */
+void drawBoard(sf::RenderTarget &target,
+               const PuzzleBoard &board,
+               const sf::Font &fontNumber,
+               float margin, float headerHeight, float topMargin,
+               float rectSize, float cornerRadius,
+               unsigned int fontSize);
+
+/**
+ * Retained renderer for the puzzle grid.
+ *
+ * All tiles live in one sf::VertexArray built once per layout: rounded
+ * corners come from a precomputed direction table, so no sin/cos runs after
+ * setLayout(). Numbers are pre-built glyph quads (one set per tile value)
+ * taken from the font's glyph texture, stored in a second vertex array.
+ * update() compares the board with what is already on screen and only
+ * patches the vertices of tiles whose value changed, and draw() submits
+ * the whole grid in two draw calls (tiles, then numbers) with no per-frame
+ * allocation.
+ */
+class BoardRenderer
+{
+public:
+    explicit BoardRenderer(const sf::Font &fontNumber);
+
+    /**
+     * Rebuild the cached geometry for a board size and layout.
+     *
+     * Matches drawBoard(): tile i sits at (originX, originY) +
+     * (column, row) * (rectSize + boardTileGap(size)).
+     *
+     * @param size         Board dimension (3..8).
+     * @param originX      X of the top-left tile.
+     * @param originY      Y of the top-left tile.
+     * @param rectSize     Tile width/height (square).
+     * @param cornerRadius Corner radius of the rounded tiles.
+     * @param fontSize     Character size of the tile numbers.
+     */
+    void setLayout(int size, float originX, float originY,
+                   float rectSize, float cornerRadius, unsigned int fontSize);
+
+    /**
+     * Patch the vertices of tiles that changed since the previous update.
+     *
+     * @param board Board to show; its size must match the current layout.
+     * @return Number of tiles whose vertices were rewritten.
+     */
+    int update(const PuzzleBoard &board);
+
+    // Outline one cell (e.g. the hinted tile) with a thick yellow border; -1 removes it
+    void setHighlight(int cell);
+
+    // Draw the grid in two draw calls (tile geometry + glyph quads)
+    void draw(sf::RenderTarget &target) const;
+
+    int size() const { return m_size; }
+
+    static constexpr int DRAW_CALLS = 2;
+
+private:
+    // Two digits at most (63-puzzle), six vertices per glyph quad
+    static constexpr int GLYPH_VERTICES = 12;
+    using NumberQuads = std::array<sf::Vertex, GLYPH_VERTICES>;
+
+    void writeTile(int cell, int value);
+    void writeBorder(int cell, bool highlighted);
+    void buildNumbers(int cellCount);
+
+    const sf::Font &m_font;
+    unsigned int m_fontSize = 0;
+    int m_size = 0;
+    int m_highlight = -1;
+    float m_originX = 0.f, m_originY = 0.f;
+    float m_pitch = 0.f, m_rectSize = 0.f, m_cornerRadius = 0.f;
+
+    sf::VertexArray m_tiles{sf::PrimitiveType::Triangles};
+    sf::VertexArray m_glyphs{sf::PrimitiveType::Triangles};
+    std::vector<NumberQuads> m_numbers; // glyph quads per tile value, centered on (0, 0)
+    std::vector<int> m_shown;           // tile values currently in the vertex arrays (-1 = stale)
+};
+
+// Result of rendering the same frames through drawBoard() and BoardRenderer
+struct RenderComparison
+{
+    int frames = 0;
+    double legacyMs = 0.0;  // average frame time of drawBoard()
+    double batchedMs = 0.0; // average frame time of BoardRenderer (including update)
+    int legacyDrawCalls = 0;
+    int batchedDrawCalls = 0;
+    std::size_t differingPixels = 0; // pixels whose color differs noticeably between the two paths
+};
+
+/**
+ * Time the per-tile drawBoard() path against BoardRenderer offscreen.
+ *
+ * Both paths render the same sequence of frames into an sf::RenderTexture
+ * (the board alternates between two positions so the batched path also pays
+ * for patching) and the GPU is synchronized before the clock stops.
+ *
+ * @param board        Board to render (left unchanged).
+ * @param fontNumber   Font used for tile numbers.
+ * @param targetSize   Size of the offscreen target (usually the window size).
+ * @param margin       Horizontal offset of the grid.
+ * @param headerHeight Vertical space reserved for the header.
+ * @param topMargin    Extra padding below the header.
+ * @param rectSize     Tile width/height.
+ * @param cornerRadius Corner radius of the tiles.
+ * @param fontSize     Character size of the tile numbers.
+ * @param frames       Frames rendered per path.
+ * @return Average frame times, draw calls per frame and the pixel difference.
+ */
+RenderComparison compareBoardRendering(const PuzzleBoard &board, const sf::Font &fontNumber,
+                                       sf::Vector2u targetSize,
+                                       float margin, float headerHeight, float topMargin,
+                                       float rectSize, float cornerRadius,
+                                       unsigned int fontSize, int frames = 300);
@@ -11,6 +11,27 @@ void centerText(sf::Text &text, float x, float y, float width, float height)
     text.setPosition({x + width / 2.f, y + height / 2.f});
 }
 
+/**
+ * Replace a text's string without a temporary sf::String.
+ *
+ * sf::Text::setString(const char *) converts into a new UTF-32 string on
+ * every call. Here the characters are appended one by one (single characters
+ * fit the small-string buffer) to storage, whose capacity survives clear(),
+ * and the text copies storage into its own string, which also keeps its
+ * capacity; once both have grown, an update allocates nothing.
+ *
+ * @param text    Text to update (unchanged strings do not touch its geometry).
+ * @param storage Scratch string kept alive across calls, one per text.
+ * @param ascii   New content (ASCII only).
+ */
+void setTextString(sf::Text &text, sf::String &storage, std::string_view ascii)
+{
+    storage.clear();
+    for (char c : ascii)
+        storage += sf::String(static_cast<char32_t>(static_cast<unsigned char>(c)));
+    text.setString(storage);
+}
+
 sf::ConvexShape createRoundedRect(float width, float height, float radius, int pointCount)
 {
     sf::ConvexShape shape;
@@ -2,7 +2,12 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <string_view>
+
 // Helper function to center text
 void centerText(sf::Text &text, float x, float y, float width, float height);
 
+// Set an ASCII string through a caller-owned sf::String, so steady updates reuse its capacity instead of allocating
+void setTextString(sf::Text &text, sf::String &storage, std::string_view ascii);
+
 sf::ConvexShape createRoundedRect(float width, float height, float radius, int pointCount = 8);
\ No newline at end of file
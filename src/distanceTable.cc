@@ -0,0 +1,350 @@
+#include "distanceTable.hh"
+#include "permutationRank.hh"
+#include "threadPool.hh"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+
+namespace
+{
+    constexpr char DISTANCE_MAGIC[8] = {'P', '1', '5', 'D', 'S', 'T', '\0', '\0'};
+    constexpr int UNREACHED = 3;
+    constexpr std::size_t CHUNK_WORDS = 4096; // frontier words (64 states each) per BFS task
+
+    using Tiles = std::array<int, DISTANCE_MAX_CELLS>;
+
+    /*
+     * Dense ranking of the solvable states of one board shape.
+     *
+     * rank = blank * half + mixed-radix value of the first n - 3 Lehmer
+     * digits (permutationRank.hh) of the tile sequence (reading order, blank skipped). The
+     * remaining two digits are implied: the last is always 0 and the one
+     * before it is fixed by the parity solvable for that blank cell.
+     */
+    struct Shape
+    {
+        int rows, cols, cells;
+        std::uint64_t half;
+
+        // Tile permutation parity that is solvable with the blank on `cell`:
+        // moving the blank up or down jumps one tile over cols - 1 others
+        int requiredParity(int cell) const
+        {
+            return ((rows - 1 - cell / cols) * (cols - 1)) & 1;
+        }
+
+        // Rank plus the check that the position is solvable
+        bool rank(const int *tiles, std::uint64_t &out) const
+        {
+            const int m = cells - 1;
+            LehmerCounter lehmer;
+            std::uint64_t r = 0;
+            int blank = -1, parity = 0;
+            for (int c = 0, i = 0; c < cells; ++c)
+            {
+                const int v = tiles[c] - 1;
+                if (v < 0)
+                {
+                    blank = c;
+                    continue;
+                }
+                const int digit = lehmer.digit(v);
+                if (i < m - 2)
+                    r = r * static_cast<std::uint64_t>(m - i) + static_cast<std::uint64_t>(digit);
+                parity += digit;
+                ++i;
+            }
+            out = static_cast<std::uint64_t>(blank) * half + r;
+            return blank >= 0 && (parity & 1) == requiredParity(blank);
+        }
+
+        void unrank(std::uint64_t rank, int *tiles) const
+        {
+            const int m = cells - 1;
+            const int blank = static_cast<int>(rank / half);
+            std::uint64_t r = rank % half;
+
+            int digits[DISTANCE_MAX_CELLS];
+            int parity = 0;
+            for (int i = m - 3; i >= 0; --i)
+            {
+                const std::uint64_t radix = static_cast<std::uint64_t>(m - i);
+                digits[i] = static_cast<int>(r % radix);
+                r /= radix;
+                parity += digits[i];
+            }
+            digits[m - 2] = (parity & 1) ^ requiredParity(blank);
+            digits[m - 1] = 0;
+
+            NibbleList unused;
+            for (int c = 0, i = 0; c < cells; ++c)
+                tiles[c] = c == blank ? 0 : unused.take(digits[i++]) + 1;
+        }
+
+        // Cells next to `cell` (up, left, right, down); returns the count
+        int neighbors(int cell, int *out) const
+        {
+            int n = 0;
+            if (cell >= cols)
+                out[n++] = cell - cols;
+            if (cell % cols > 0)
+                out[n++] = cell - 1;
+            if (cell % cols < cols - 1)
+                out[n++] = cell + 1;
+            if (cell + cols < cells)
+                out[n++] = cell + cols;
+            return n;
+        }
+    };
+
+    Shape shapeOf(int rows, int cols)
+    {
+        std::uint64_t half = 1;
+        for (int i = 2; i < rows * cols; ++i)
+            half *= static_cast<std::uint64_t>(i);
+        return {rows, cols, rows * cols, half / 2};
+    }
+
+    // Write `value` into an unreached entry; false if another thread (or an earlier level) got there first
+    bool claim(std::uint64_t *words, std::uint64_t rank, std::uint64_t value)
+    {
+        std::atomic_ref<std::uint64_t> word(words[rank / 32]);
+        const int shift = static_cast<int>(2 * (rank % 32));
+        std::uint64_t old = word.load(std::memory_order_relaxed);
+        do
+        {
+            if (((old >> shift) & 3) != UNREACHED)
+                return false;
+        } while (!word.compare_exchange_weak(old, (old & ~(3ull << shift)) | (value << shift),
+                                             std::memory_order_relaxed));
+        return true;
+    }
+}
+
+bool DistanceTable::supports(int rows, int cols)
+{
+    return rows >= 2 && cols >= 2 && rows * cols <= DISTANCE_MAX_CELLS;
+}
+
+void DistanceTable::setShape(int rows, int cols)
+{
+    const Shape shape = shapeOf(rows, cols);
+    m_rows = rows;
+    m_cols = cols;
+    m_cells = shape.cells;
+    m_half = shape.half;
+    m_stateCount = static_cast<std::uint64_t>(m_cells) * m_half;
+    m_goalRank = static_cast<std::uint64_t>(m_cells - 1) * m_half; // blank last, tiles in order
+}
+
+bool DistanceTable::build(int rows, int cols, unsigned threads, std::ostream *log)
+{
+    if (!supports(rows, cols))
+        return false;
+
+    m_file.close();
+    setShape(rows, cols);
+    const Shape shape = shapeOf(rows, cols);
+    m_owned.assign((m_stateCount + 31) / 32, ~0ull);
+    m_words = m_owned.data();
+    m_histogram.assign(DISTANCE_MAX_DEPTH, 0);
+    m_maxDistance = 0;
+
+    std::vector<std::uint64_t> frontier((m_stateCount + 63) / 64, 0);
+    std::vector<std::uint64_t> next(frontier.size(), 0);
+    claim(m_owned.data(), m_goalRank, 0);
+    frontier[m_goalRank / 64] |= 1ull << (m_goalRank % 64);
+    m_histogram[0] = 1;
+
+    WorkStealingPool pool(threads);
+    for (int depth = 0; depth + 1 < DISTANCE_MAX_DEPTH; ++depth)
+    {
+        const std::uint64_t value = static_cast<std::uint64_t>((depth + 1) % 3);
+        std::atomic<std::uint64_t> reached{0};
+
+        for (std::size_t first = 0; first < frontier.size(); first += CHUNK_WORDS)
+            pool.submit([&, first]
+                        {
+                            const std::size_t last = std::min(first + CHUNK_WORDS, frontier.size());
+                            std::uint64_t local = 0;
+                            Tiles tiles;
+                            int around[4];
+                            for (std::size_t w = first; w < last; ++w)
+                                for (std::uint64_t bits = frontier[w]; bits; bits &= bits - 1)
+                                {
+                                    const std::uint64_t state = w * 64 + static_cast<std::uint64_t>(std::countr_zero(bits));
+                                    shape.unrank(state, tiles.data());
+                                    const int blank = static_cast<int>(state / m_half);
+                                    const std::uint64_t tileRank = state % m_half;
+
+                                    for (int k = 0, n = shape.neighbors(blank, around); k < n; ++k)
+                                    {
+                                        // Sideways moves keep the tile order: only the blank part of the rank changes
+                                        const int cell = around[k];
+                                        std::uint64_t target = static_cast<std::uint64_t>(cell) * m_half + tileRank;
+                                        if (cell / m_cols != blank / m_cols)
+                                        {
+                                            std::swap(tiles[blank], tiles[cell]);
+                                            shape.rank(tiles.data(), target);
+                                            std::swap(tiles[blank], tiles[cell]);
+                                        }
+                                        if (claim(m_owned.data(), target, value))
+                                        {
+                                            std::atomic_ref<std::uint64_t>(next[target / 64]).fetch_or(1ull << (target % 64), std::memory_order_relaxed);
+                                            ++local;
+                                        }
+                                    }
+                                }
+                            reached += local; });
+        pool.wait();
+
+        if (reached == 0)
+            break;
+        m_histogram[depth + 1] = reached;
+        m_maxDistance = depth + 1;
+        if (log)
+            *log << "Distance " << depth + 1 << ": " << reached << " states\n";
+
+        frontier.swap(next);
+        std::fill(next.begin(), next.end(), 0);
+    }
+    return true;
+}
+
+bool DistanceTable::save(const std::string &path) const
+{
+    if (!isLoaded())
+        return false;
+
+    DistanceFileHeader header{};
+    std::memcpy(header.magic, DISTANCE_MAGIC, sizeof(DISTANCE_MAGIC));
+    header.version = DISTANCE_FORMAT_VERSION;
+    header.rows = static_cast<std::uint32_t>(m_rows);
+    header.cols = static_cast<std::uint32_t>(m_cols);
+    header.maxDistance = static_cast<std::uint32_t>(m_maxDistance);
+    header.stateCount = m_stateCount;
+    std::copy(m_histogram.begin(), m_histogram.end(), header.histogram);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(m_words), static_cast<std::streamsize>(tableBytes()));
+    return static_cast<bool>(out);
+}
+
+bool DistanceTable::load(const std::string &path)
+{
+    m_words = nullptr;
+    m_owned.clear();
+    if (!m_file.open(path) || m_file.size() < sizeof(DistanceFileHeader))
+        return false;
+
+    DistanceFileHeader header;
+    std::memcpy(&header, m_file.data(), sizeof(header));
+    const bool valid = std::memcmp(header.magic, DISTANCE_MAGIC, sizeof(DISTANCE_MAGIC)) == 0 &&
+                       header.version == DISTANCE_FORMAT_VERSION &&
+                       supports(static_cast<int>(header.rows), static_cast<int>(header.cols)) &&
+                       header.maxDistance < DISTANCE_MAX_DEPTH;
+    if (valid)
+        setShape(static_cast<int>(header.rows), static_cast<int>(header.cols));
+    if (!valid || header.stateCount != m_stateCount || m_file.size() < sizeof(header) + tableBytes())
+    {
+        m_file.close();
+        return false;
+    }
+
+    m_maxDistance = static_cast<int>(header.maxDistance);
+    m_histogram.assign(header.histogram, header.histogram + DISTANCE_MAX_DEPTH);
+    m_words = reinterpret_cast<const std::uint64_t *>(m_file.data() + sizeof(header));
+    return true;
+}
+
+std::uint64_t DistanceTable::rank(std::span<const int> tiles) const
+{
+    std::uint64_t r = 0;
+    shapeOf(m_rows, m_cols).rank(tiles.data(), r);
+    return r;
+}
+
+bool DistanceTable::solve(std::span<const int> tiles, std::vector<int> &moves) const
+{
+    moves.clear();
+    if (!isLoaded() || static_cast<int>(tiles.size()) != m_cells)
+        return false;
+
+    const Shape shape = shapeOf(m_rows, m_cols);
+    Tiles state{};
+    std::copy(tiles.begin(), tiles.end(), state.begin());
+    std::uint64_t r = 0;
+    if (!shape.rank(state.data(), r) || distanceMod3(r) == UNREACHED)
+        return false;
+
+    int blank = static_cast<int>(r / m_half);
+    int around[4];
+    for (int residue = distanceMod3(r); r != m_goalRank;)
+    {
+        // The neighbor one move closer has residue - 1 (mod 3); the farther one has residue + 1
+        const int closer = (residue + 2) % 3;
+        int k = 0, n = shape.neighbors(blank, around);
+        std::uint64_t target = 0;
+        for (; k < n; ++k)
+        {
+            std::swap(state[blank], state[around[k]]);
+            shape.rank(state.data(), target);
+            if (distanceMod3(target) == closer)
+                break;
+            std::swap(state[blank], state[around[k]]);
+        }
+        if (k == n)
+            return false; // corrupt table
+
+        blank = around[k];
+        moves.push_back(blank);
+        r = target;
+        residue = closer;
+        if (static_cast<int>(moves.size()) > m_maxDistance)
+            return false;
+    }
+    return true;
+}
+
+int DistanceTable::distance(std::span<const int> tiles) const
+{
+    std::vector<int> moves;
+    moves.reserve(static_cast<std::size_t>(m_maxDistance));
+    return solve(tiles, moves) ? static_cast<int>(moves.size()) : -1;
+}
+
+int DistanceTable::bestMove(std::span<const int> tiles) const
+{
+    if (!isLoaded() || static_cast<int>(tiles.size()) != m_cells)
+        return -1;
+
+    const Shape shape = shapeOf(m_rows, m_cols);
+    Tiles state{};
+    std::copy(tiles.begin(), tiles.end(), state.begin());
+    std::uint64_t r = 0;
+    if (!shape.rank(state.data(), r))
+        return -1;
+
+    const int residue = distanceMod3(r);
+    const int blank = static_cast<int>(r / m_half);
+    if (residue == UNREACHED || r == m_goalRank)
+        return -1;
+
+    int around[4];
+    for (int k = 0, n = shape.neighbors(blank, around); k < n; ++k)
+    {
+        std::swap(state[blank], state[around[k]]);
+        std::uint64_t target = 0;
+        shape.rank(state.data(), target);
+        std::swap(state[blank], state[around[k]]);
+        if (distanceMod3(target) == (residue + 2) % 3)
+            return around[k];
+    }
+    return -1;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "mappedFile.hh"
+
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Exact distance to the goal for every solvable state of a small board.
+ *
+ * Supports rows x cols boards with at most 12 cells (3x3, 2x4, 3x4, ...).
+ * The goal matches the game: tiles 1..n-1 in reading order, blank last.
+ *
+ * States are ranked by blank cell and the tile permutation in reading
+ * order. For a given blank cell only one permutation parity is solvable,
+ * so the last two Lehmer digits collapse into one and the rank is dense:
+ * cells * (n-1)! / 2 entries (239,500,800 for 3x4).
+ *
+ * Each entry stores the distance modulo 3 in 2 bits (3 = unreached), so
+ * the 3x4 table is about 60 MB. Neighbors always differ by exactly one move,
+ * hence their residues tell apart the neighbor one move closer to the goal:
+ * walking down that gradient recovers the exact distance and an optimal
+ * path, and a single step gives an O(1) optimal hint.
+ *
+ * On-disk format (little endian): DistanceFileHeader, then the 2-bit entries
+ * packed into 64-bit words (entry i in bits [2 * (i % 32), +2) of word i / 32).
+ * load() memory-maps the file.
+ */
+
+constexpr std::uint32_t DISTANCE_FORMAT_VERSION = 1;
+constexpr int DISTANCE_MAX_CELLS = 12;
+constexpr int DISTANCE_MAX_DEPTH = 96; // histogram slots (3x4 needs 54)
+
+struct DistanceFileHeader
+{
+    char magic[8]; // "P15DST\0\0"
+    std::uint32_t version;
+    std::uint32_t rows;
+    std::uint32_t cols;
+    std::uint32_t maxDistance;
+    std::uint64_t stateCount;
+    std::uint64_t histogram[DISTANCE_MAX_DEPTH]; // states at each exact distance
+};
+
+class DistanceTable
+{
+public:
+    static bool supports(int rows, int cols);
+
+    /**
+     * Fill the table by breadth-first search from the goal.
+     *
+     * Each level scans a bitmap of the current frontier in chunks on a
+     * thread pool; newly reached states are claimed with an atomic
+     * compare-and-swap on their 64-bit word, so every state is expanded once.
+     *
+     * @param rows    Board height.
+     * @param cols    Board width.
+     * @param threads Worker count (0 = one per hardware thread).
+     * @param log     Optional per-level progress output.
+     * @return false if the shape is not supported.
+     */
+    bool build(int rows, int cols, unsigned threads = 0, std::ostream *log = nullptr);
+
+    // Map a table written by save(); false if missing or malformed
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+
+    bool isLoaded() const { return m_words != nullptr; }
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+    std::uint64_t stateCount() const { return m_stateCount; }
+    int maxDistance() const { return m_maxDistance; }
+    std::size_t tableBytes() const { return (m_stateCount + 31) / 32 * sizeof(std::uint64_t); }
+
+    // States at each exact distance 0..maxDistance()
+    std::span<const std::uint64_t> histogram() const { return {m_histogram.data(), static_cast<std::size_t>(m_maxDistance + 1)}; }
+
+    // Dense rank of a solvable position (tiles in reading order, 0 = blank)
+    std::uint64_t rank(std::span<const int> tiles) const;
+
+    // Stored residue: distance % 3, or 3 for unreachable ranks
+    int distanceMod3(std::uint64_t rank) const
+    {
+        return static_cast<int>((m_words[rank / 32] >> (2 * (rank % 32))) & 3);
+    }
+
+    // Exact optimal distance (gradient walk, O(distance)); -1 if unsolvable
+    int distance(std::span<const int> tiles) const;
+
+    // Cell of the tile to slide next on an optimal path; -1 if solved or unsolvable
+    int bestMove(std::span<const int> tiles) const;
+
+    // Optimal move sequence (blank destinations, like SolverResult::moves); false if unsolvable
+    bool solve(std::span<const int> tiles, std::vector<int> &moves) const;
+
+private:
+    void setShape(int rows, int cols);
+
+    int m_rows = 0, m_cols = 0, m_cells = 0;
+    std::uint64_t m_half = 0; // (cells - 1)! / 2 permutations per blank cell
+    std::uint64_t m_stateCount = 0;
+    std::uint64_t m_goalRank = 0;
+    int m_maxDistance = 0;
+    std::vector<std::uint64_t> m_histogram;
+
+    MappedFile m_file;
+    std::vector<std::uint64_t> m_owned; // table built in memory
+    const std::uint64_t *m_words = nullptr;
+};
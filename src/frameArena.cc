@@ -0,0 +1,70 @@
+#include "frameArena.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace
+{
+    std::size_t alignUp(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+FrameArena::FrameArena(std::size_t bytes)
+    : m_buffer(std::make_unique<std::byte[]>(bytes)), m_capacity(bytes)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    releaseOverflow();
+}
+
+void FrameArena::reset()
+{
+    m_highWater = std::max(m_highWater, m_used);
+    m_offset = 0;
+    m_used = 0;
+    releaseOverflow();
+}
+
+/**
+ * Hand out the next aligned block of the buffer.
+ *
+ * Blocks that do not fit get their own allocation, prefixed by an Overflow
+ * header that links them for the next reset().
+ *
+ * @param bytes     Block size.
+ * @param alignment Required alignment (a power of two).
+ * @return The block; valid until the next reset().
+ */
+void *FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    m_used += bytes;
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+    const std::size_t start = alignUp(base + m_offset, alignment) - base;
+    if (start + bytes <= m_capacity)
+    {
+        m_offset = start + bytes;
+        return m_buffer.get() + start;
+    }
+
+    ++m_overflows;
+    const std::size_t blockAlignment = std::max(alignment, alignof(Overflow));
+    const std::size_t header = alignUp(sizeof(Overflow), blockAlignment);
+    auto *block = static_cast<std::byte *>(::operator new(header + bytes, std::align_val_t(blockAlignment)));
+    m_overflow = new (block) Overflow{m_overflow, header + bytes, blockAlignment};
+    return block + header;
+}
+
+void FrameArena::releaseOverflow()
+{
+    while (m_overflow)
+    {
+        Overflow *next = m_overflow->next;
+        ::operator delete(m_overflow, m_overflow->bytes, std::align_val_t(m_overflow->alignment));
+        m_overflow = next;
+    }
+}
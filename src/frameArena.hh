@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * Bump allocator for scratch data that lives for one frame.
+ *
+ * Allocations advance a pointer through a buffer reserved once; deallocate
+ * is a no-op and reset() at the start of each frame makes the whole buffer
+ * available again, so per-frame strings and vectors (std::pmr containers
+ * built on resource()) cost no heap traffic. A frame that needs more than
+ * the buffer falls back to operator new for the excess; those blocks are
+ * freed by the next reset() and counted so the buffer can be resized.
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t DEFAULT_BYTES = 64 * 1024;
+
+    explicit FrameArena(std::size_t bytes = DEFAULT_BYTES);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    // Start a new frame: everything allocated since the previous reset is dropped
+    void reset();
+
+    std::size_t capacity() const { return m_capacity; }
+    std::size_t used() const { return m_used; }           // bytes handed out this frame
+    std::size_t highWater() const { return m_highWater; } // most bytes used by one frame
+    std::size_t overflows() const { return m_overflows; } // allocations that did not fit, since construction
+
+private:
+    struct Overflow
+    {
+        Overflow *next;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    void releaseOverflow();
+
+    std::unique_ptr<std::byte[]> m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_offset = 0;
+    std::size_t m_used = 0;
+    std::size_t m_highWater = 0;
+    std::size_t m_overflows = 0;
+    Overflow *m_overflow = nullptr; // blocks allocated past the buffer this frame
+};
@@ -0,0 +1,82 @@
+#include "frameScheduler.hh"
+
+#include <algorithm>
+
+FrameScheduler::FrameScheduler(unsigned int maxFps)
+    : m_maxFps(maxFps),
+      m_minFrameInterval(maxFps ? sf::microseconds(1'000'000 / maxFps) : sf::Time::Zero)
+{
+}
+
+void FrameScheduler::redrawIn(sf::Time delay)
+{
+    const sf::Time at = m_clock.getElapsedTime() + std::max(delay, sf::Time::Zero);
+    m_deadline = m_deadline ? std::min(*m_deadline, at) : at;
+}
+
+std::optional<sf::Time> FrameScheduler::nextFrameTime() const
+{
+    // Earliest moment the cap allows another frame
+    const sf::Time earliest = m_lastFrame ? *m_lastFrame + m_minFrameInterval : sf::Time::Zero;
+
+    if (m_dirty || m_animating)
+        return earliest;
+    if (m_deadline)
+        return std::max(*m_deadline, earliest);
+    return std::nullopt;
+}
+
+/**
+ * Read the next event, sleeping in the OS until input arrives or a frame is due.
+ *
+ * With nothing pending the call blocks indefinitely; with a pending frame it
+ * waits at most until that frame's due time; once the frame is due it only
+ * drains events that are already queued.
+ *
+ * @param window Window whose events are read.
+ * @return The next event, or std::nullopt when the caller should try to draw.
+ */
+std::optional<sf::Event> FrameScheduler::waitEvent(sf::Window &window)
+{
+    const std::optional<sf::Time> due = nextFrameTime();
+    if (!due)
+        return window.waitEvent(); // no timeout: sleep until input
+
+    const sf::Time now = m_clock.getElapsedTime();
+    if (*due <= now)
+        return window.pollEvent();
+    return window.waitEvent(*due - now);
+}
+
+bool FrameScheduler::beginFrame()
+{
+    const std::optional<sf::Time> due = nextFrameTime();
+    const sf::Time now = m_clock.getElapsedTime();
+    if (!due || *due > now)
+    {
+        ++m_idleWakeups;
+        return false;
+    }
+
+    m_lastFrame = now;
+    m_dirty = false;
+    m_deadline.reset();
+    ++m_framesDrawn;
+    return true;
+}
+
+std::uint64_t FrameScheduler::framesSkipped() const
+{
+    if (!m_maxFps)
+        return 0;
+    const auto possible = static_cast<std::uint64_t>(m_clock.getElapsedTime().asSeconds() * m_maxFps);
+    return possible > m_framesDrawn ? possible - m_framesDrawn : 0;
+}
+
+void FrameScheduler::report(std::ostream &out) const
+{
+    const float seconds = m_clock.getElapsedTime().asSeconds();
+    out << "Frames: " << m_framesDrawn << " drawn in " << seconds << " s ("
+        << (seconds > 0 ? m_framesDrawn / seconds : 0.f) << " fps average, cap " << m_maxFps << "), "
+        << framesSkipped() << " skipped, " << m_idleWakeups << " idle wakeups\n";
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+
+/**
+ * Decides when the main loop redraws instead of redrawing every iteration.
+ *
+ * A frame is drawn only when something visible changed: input handled by
+ * the caller (invalidate), a scheduled deadline such as the next timer
+ * second (redrawIn), or a running animation (setAnimating). Frames are never
+ * drawn closer together than the configured cap. In between, waitEvent()
+ * blocks on the window's event queue, so an idle game uses next to no CPU.
+ *
+ * Typical loop:
+ *   while (auto event = scheduler.waitEvent(window)) { handle; scheduler.invalidate(); }
+ *   if (scheduler.beginFrame()) { draw; display; scheduler.redrawIn(...); }
+ */
+class FrameScheduler
+{
+public:
+    // maxFps limits the redraw rate while animating or under bursts of input (0 = no cap)
+    explicit FrameScheduler(unsigned int maxFps = 60);
+
+    // Something on screen changed; redraw as soon as the cap allows
+    void invalidate() { m_dirty = true; }
+
+    // Redraw continuously (at the cap) while an animation is running
+    void setAnimating(bool animating) { m_animating = animating; }
+
+    // Schedule a redraw after `delay` (keeps the earliest pending deadline)
+    void redrawIn(sf::Time delay);
+
+    /**
+     * Next window event, blocking until one arrives or a frame is due.
+     *
+     * @param window Window whose event queue is read.
+     * @return The event, or std::nullopt once a frame is due and the queue is empty.
+     */
+    std::optional<sf::Event> waitEvent(sf::Window &window);
+
+    // True if a frame should be drawn now; counts the frame (or the skipped wakeup)
+    bool beginFrame();
+
+    unsigned int maxFps() const { return m_maxFps; }
+    std::uint64_t framesDrawn() const { return m_framesDrawn; }
+    std::uint64_t idleWakeups() const { return m_idleWakeups; }
+
+    // Frames avoided compared with redrawing continuously at the cap for the whole run
+    std::uint64_t framesSkipped() const;
+
+    // Print drawn/skipped frame counts (e.g. when the window closes)
+    void report(std::ostream &out) const;
+
+private:
+    // Time at which the next frame is due, or nullopt if nothing is pending
+    std::optional<sf::Time> nextFrameTime() const;
+
+    sf::Clock m_clock;
+    unsigned int m_maxFps;
+    sf::Time m_minFrameInterval;
+    std::optional<sf::Time> m_lastFrame;
+    std::optional<sf::Time> m_deadline;
+    bool m_dirty = true; // the first frame is always drawn
+    bool m_animating = false;
+
+    std::uint64_t m_framesDrawn = 0;
+    std::uint64_t m_idleWakeups = 0;
+};
@@ -0,0 +1,82 @@
+#include "gameState.hh"
+#include "replay.hh"
+
+#include <chrono>
+
+std::uint64_t SteadyGameClock::nowMilliseconds() const
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+GameState::GameState(const GameClock &clock, std::uint64_t seed)
+    : m_clock(clock), m_seed(seed), m_rng(seed)
+{
+    m_events.reserve(8); // a move queues at most two events; no allocation while playing
+    m_startTime = m_clock.nowMilliseconds();
+}
+
+/**
+ * Start a new game: reset to the requested size, shuffle, zero the counters.
+ *
+ * @param size Board dimension (clamped to the supported range).
+ */
+void GameState::restart(int size)
+{
+    const std::uint64_t now = m_clock.nowMilliseconds();
+    if (m_recorder)
+        m_recorder->restart(now, size);
+
+    m_board.reset(size);
+    m_board.shuffle(m_rng);
+    m_moveCount = 0;
+    m_won = false;
+    m_startTime = now;
+    m_winTime = 0;
+    m_events.push_back({GameEventType::Restarted, -1, now});
+}
+
+/**
+ * Attempt to move a tile into the empty space if adjacent.
+ *
+ * @param targetX Column of the tile to move (0-based).
+ * @param targetY Row of the tile to move (0-based).
+ * @return true if the tile moved.
+ */
+bool GameState::tryMove(int targetX, int targetY)
+{
+    const std::uint64_t now = m_clock.nowMilliseconds();
+    if (m_recorder)
+        m_recorder->move(now, targetX, targetY);
+
+    if (!m_board.moveTile(targetX, targetY))
+        return false;
+
+    ++m_moveCount;
+    const int cell = targetY * m_board.size() + targetX;
+    m_events.push_back({GameEventType::Moved, cell, now});
+
+    // Check if puzzle is solved
+    if (m_board.isSolved())
+    {
+        m_won = true;
+        m_winTime = now;
+        m_events.push_back({GameEventType::Won, cell, now});
+    }
+    return true;
+}
+
+std::uint64_t GameState::elapsedMilliseconds() const
+{
+    const std::uint64_t end = m_won ? m_winTime : m_clock.nowMilliseconds();
+    return end > m_startTime ? end - m_startTime : 0;
+}
+
+std::uint64_t GameState::millisecondsSinceWin() const
+{
+    if (!m_won)
+        return 0;
+    const std::uint64_t now = m_clock.nowMilliseconds();
+    return now > m_winTime ? now - m_winTime : 0;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "board.hh"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class ReplayWriter;
+
+// Time source of the game in milliseconds; inject a manual clock for tests and replays
+class GameClock
+{
+public:
+    virtual ~GameClock() = default;
+    virtual std::uint64_t nowMilliseconds() const = 0;
+};
+
+// Wall clock (std::chrono::steady_clock) for interactive play
+class SteadyGameClock : public GameClock
+{
+public:
+    std::uint64_t nowMilliseconds() const override;
+};
+
+// Clock that only moves when told to (replays, tests, simulations)
+class ManualGameClock : public GameClock
+{
+public:
+    std::uint64_t nowMilliseconds() const override { return m_now; }
+    void set(std::uint64_t milliseconds) { m_now = milliseconds; }
+
+private:
+    std::uint64_t m_now = 0;
+};
+
+// Something the presentation layer may react to (sounds, music, effects)
+enum class GameEventType : std::uint8_t
+{
+    Restarted, // new shuffled board
+    Moved,     // a tile slid into the empty cell
+    Won        // the move solved the puzzle
+};
+
+struct GameEvent
+{
+    GameEventType type;
+    int cell = -1;          // cell the move targeted (Moved)
+    std::uint64_t time = 0; // game clock at the event
+};
+
+/**
+ * Headless game rules: board, move counter, timer and win detection.
+ *
+ * No SFML dependency; time comes from an injected GameClock and shuffles
+ * from a seeded RandomEngine, so the same seed and inputs always give the
+ * same game. Instead of playing sounds it queues GameEvents that the caller
+ * drains with events()/clearEvents(). An optional ReplayWriter records every
+ * input so a session can be replayed exactly (see replay.hh).
+ */
+class GameState
+{
+public:
+    GameState(const GameClock &clock, std::uint64_t seed);
+
+    // Record every input from now on (nullptr stops recording)
+    void setRecorder(ReplayWriter *recorder) { m_recorder = recorder; }
+
+    // Start a new shuffled game of the given size (clamped to 3..8)
+    void restart(int size);
+
+    /**
+     * Slide the tile at (targetX, targetY) into the empty cell if adjacent.
+     *
+     * Counts the move, queues Moved (and Won whenever it solves the puzzle;
+     * the win time is that of the latest solving move).
+     *
+     * @return true if the tile moved.
+     */
+    bool tryMove(int targetX, int targetY);
+
+    const PuzzleBoard &board() const { return m_board; }
+    std::uint64_t seed() const { return m_seed; }
+    int moveCount() const { return m_moveCount; }
+    bool won() const { return m_won; }
+
+    // Time since restart, frozen at the winning move
+    std::uint64_t elapsedMilliseconds() const;
+    int elapsedSeconds() const { return static_cast<int>(elapsedMilliseconds() / 1000); }
+
+    // Time since the winning move (0 while not won)
+    std::uint64_t millisecondsSinceWin() const;
+
+    // Effects queued since the last clearEvents()
+    std::span<const GameEvent> events() const { return m_events; }
+    void clearEvents() { m_events.clear(); }
+
+private:
+    const GameClock &m_clock;
+    std::uint64_t m_seed;
+    RandomEngine m_rng;
+    PuzzleBoard m_board;
+    ReplayWriter *m_recorder = nullptr;
+
+    int m_moveCount = 0;
+    bool m_won = false;
+    std::uint64_t m_startTime = 0;
+    std::uint64_t m_winTime = 0;
+    std::vector<GameEvent> m_events;
+};
@@ -0,0 +1,199 @@
+#include "hintService.hh"
+
+#include <algorithm>
+
+namespace
+{
+    // Leave one hardware thread to the render loop
+    unsigned searchThreads()
+    {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 2 ? hardware - 1 : 1;
+    }
+}
+
+HintService::HintService(const SolverOptions &options)
+    : m_options(options), m_pool(searchThreads())
+{
+    m_options.cancel = &m_cancel;
+    m_path.reserve(128);
+    m_worker = std::thread(&HintService::run, this);
+}
+
+HintService::~HintService()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+        m_cancel = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+/**
+ * Post the new board and drop any hint or search for the previous one.
+ *
+ * @param board Board after the move or restart.
+ */
+void HintService::update(const PuzzleBoard &board)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        ++m_generation;
+        m_cancel = true; // whatever the worker is solving is stale now
+        m_requestPending = false;
+        m_requestSize = board.size();
+        m_supported = m_requestSize <= 4;
+        if (!m_supported)
+            return;
+
+        std::copy(board.tiles().begin(), board.tiles().end(), m_request.begin());
+        m_requestEmpty = board.emptyIdx();
+        m_requestTime = std::chrono::steady_clock::now();
+        if (m_requestSize == 3 ? answerFromTable() : reusePath(packBoard(m_request)))
+            return;
+        m_requestPending = true;
+    }
+    m_wake.notify_one();
+}
+
+/**
+ * Publish the 3x3 hint from the distance table once it exists.
+ *
+ * @return true if the hint was published.
+ */
+bool HintService::answerFromTable()
+{
+    if (!m_table3Ready)
+        return false;
+
+    const std::span<const int> tiles(m_request.data(), 9);
+    publish(m_generation, m_table3.bestMove(tiles), m_table3.distance(tiles));
+    return true;
+}
+
+/**
+ * Publish a hint straight from the cached path when the board lies on it.
+ *
+ * Every suffix of an optimal path is optimal, so after k moves along the path
+ * the next hint is path[k] with path.size() - k moves left.
+ *
+ * @param board Current position.
+ * @return true if the hint was published without a search.
+ */
+bool HintService::reusePath(PackedBoard board)
+{
+    PackedBoard state = m_pathStart;
+    int empty = m_pathEmpty;
+    for (std::size_t k = 0; k <= m_path.size(); ++k)
+    {
+        if (state == board)
+        {
+            ++m_reused;
+            const int remaining = static_cast<int>(m_path.size() - k);
+            publish(m_generation, remaining ? m_path[k] : -1, remaining);
+            return true;
+        }
+        if (k == m_path.size())
+            break;
+        state = slideTile(state, empty, m_path[k]);
+        empty = m_path[k];
+    }
+    return false;
+}
+
+void HintService::publish(std::uint64_t generation, int cell, int remaining)
+{
+    m_readyGeneration = generation;
+    m_ready = {cell, remaining};
+    ++m_published;
+    m_latencyMs[m_latencyNext] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_requestTime).count();
+    m_latencyNext = (m_latencyNext + 1) % LATENCY_HISTORY;
+    m_latencyStored = std::min(m_latencyStored + 1, LATENCY_HISTORY);
+}
+
+Hint HintService::hint() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_readyGeneration == m_generation ? m_ready : Hint{};
+}
+
+bool HintService::pending() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_supported && m_readyGeneration != m_generation;
+}
+
+// Worker: always solve the most recent request, abandoning searches that became stale
+void HintService::run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this]
+                    { return m_stopping || m_requestPending; });
+        if (m_stopping)
+            return;
+
+        if (m_requestSize == 3)
+        {
+            // One-off build (a few tens of milliseconds), then every 3x3 hint is a table lookup
+            // (the request may have changed meanwhile, so look at it again afterwards)
+            if (!m_table3Ready)
+            {
+                lock.unlock();
+                m_table3.build(3, 3, 1);
+                lock.lock();
+                m_table3Ready = true;
+                continue;
+            }
+            m_requestPending = false;
+            answerFromTable();
+            continue;
+        }
+
+        const PackedBoard board = packBoard(m_request);
+        const int empty = m_requestEmpty;
+        const std::uint64_t generation = m_generation;
+        m_requestPending = false;
+        m_cancel = false;
+        ++m_searches;
+        lock.unlock();
+
+        // Hard positions can take seconds on one core; split them over the pool when there is one
+        SolverResult result = m_pool.size() > 1 ? solvePuzzleParallel(unpackBoard(board), empty, m_pool, m_options)
+                                                : solvePuzzle(unpackBoard(board), empty, m_options);
+
+        lock.lock();
+        if (result.cancelled)
+        {
+            ++m_cancelled;
+            continue;
+        }
+        if (!result.solved)
+            continue;
+
+        m_pathStart = board;
+        m_pathEmpty = empty;
+        m_path = std::move(result.moves);
+        if (generation == m_generation)
+            publish(generation, m_path.empty() ? -1 : m_path.front(), static_cast<int>(m_path.size()));
+    }
+}
+
+void HintService::report(std::ostream &out) const
+{
+    std::lock_guard lock(m_mutex);
+    std::vector<double> sorted(m_latencyMs.begin(), m_latencyMs.begin() + m_latencyStored);
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p)
+    {
+        return sorted.empty() ? 0.0 : sorted[static_cast<std::size_t>(p * (sorted.size() - 1))];
+    };
+
+    out << "Hints: " << m_published << " published (" << m_reused << " from the previous path), "
+        << m_searches << " searches, " << m_cancelled << " cancelled; latency over the last " << sorted.size()
+        << " p50 " << percentile(0.5)
+        << " ms, p95 " << percentile(0.95) << " ms, max " << percentile(1.0) << " ms\n";
+}
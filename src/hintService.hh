@@ -0,0 +1,112 @@
+#pragma once
+
+#include "board.hh"
+#include "distanceTable.hh"
+#include "packedBoard.hh"
+#include "solver.hh"
+#include "threadPool.hh"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+// Next optimal move for the current board
+struct Hint
+{
+    int cell = -1;     // cell of the tile to slide, -1 while no hint is ready
+    int remaining = 0; // optimal number of moves left
+};
+
+/**
+ * Computes hints on a worker thread so the render loop never waits for the solver.
+ *
+ * update() is called from the main thread after every board change; it only
+ * posts the new position and raises the cancel flag of a search that is
+ * still running for an older one. The worker solves the latest position and
+ * publishes the first move of the optimal path. The path is kept: if a later
+ * board lies on it (typically the player followed the hint), the rest of the
+ * path is still optimal and the hint is published immediately without a
+ * search. hint() returns only results for the current board.
+ *
+ * 3x3 boards are answered from an exact distance table instead (built on
+ * the worker the first time, then O(1) per hint, straight from update()).
+ * 4x4 boards use the IDA* solver, split over a small worker pool when the
+ * machine has cores to spare; larger sizes get no hint.
+ */
+class HintService
+{
+public:
+    explicit HintService(const SolverOptions &options = {});
+    ~HintService();
+
+    HintService(const HintService &) = delete;
+    HintService &operator=(const HintService &) = delete;
+
+    // The board changed (move or restart); cheap, never blocks on a search
+    void update(const PuzzleBoard &board);
+
+    // Ready hint for the board of the last update(), or cell == -1 if none yet
+    Hint hint() const;
+
+    // A hint for the current board is still being computed
+    bool pending() const;
+
+    // Print searches, reuses, cancellations and update-to-hint latency (over the last LATENCY_HISTORY hints)
+    void report(std::ostream &out) const;
+
+private:
+    void run();
+    bool reusePath(PackedBoard board);     // requires m_mutex
+    bool answerFromTable();                // requires m_mutex
+    void publish(std::uint64_t generation, int cell, int remaining); // requires m_mutex
+
+    SolverOptions m_options;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_cancel{false};
+    bool m_stopping = false;
+
+    // Latest request (written by update(), taken by the worker)
+    std::uint64_t m_generation = 0;
+    bool m_supported = false;
+    bool m_requestPending = false;
+    int m_requestSize = 0;
+    std::array<int, 16> m_request{};
+    int m_requestEmpty = 15;
+    std::chrono::steady_clock::time_point m_requestTime;
+
+    // Published hint and the generation it belongs to
+    std::uint64_t m_readyGeneration = ~0ull;
+    Hint m_ready;
+
+    // Last optimal path (blank destinations) and the position it starts from
+    PackedBoard m_pathStart = PACKED_SOLVED;
+    int m_pathEmpty = 15;
+    std::vector<int> m_path;
+
+    // Exact 3x3 distances; written once by the worker, read under m_mutex afterwards
+    DistanceTable m_table3;
+    bool m_table3Ready = false;
+
+    std::uint64_t m_searches = 0;
+    std::uint64_t m_reused = 0;
+    std::uint64_t m_cancelled = 0;
+    std::uint64_t m_published = 0;
+
+    // update() to published hint, for the last LATENCY_HISTORY hints
+    static constexpr std::size_t LATENCY_HISTORY = 1024;
+    std::array<double, LATENCY_HISTORY> m_latencyMs{};
+    std::size_t m_latencyNext = 0;   // ring position of the next sample
+    std::size_t m_latencyStored = 0; // samples in the ring (<= LATENCY_HISTORY)
+
+    WorkStealingPool m_pool; // subtree workers of the 4x4 search (one thread on small machines)
+
+    std::thread m_worker; // started last, once every member is initialized
+};
@@ -1,9 +1,25 @@
+#include "allocTracker.hh"
+#include "assetManager.hh"
 #include "board.hh"
+#include "boardRenderer.hh"
+#include "frameScheduler.hh"
+#include "gameState.hh"
+#include "hintService.hh"
 #include "createShape.hh"
+#include "frameArena.hh"
 #include "utilities.hh"
 #include "UI.hh"
+#include "patternDB.hh"
+#include "profiler.hh"
+#include "replay.hh"
+#include "soundService.hh"
+#include "transpositionTable.hh"
 
 #include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
 #include <string>
 
 #if defined(__APPLE__)
@@ -29,12 +45,6 @@ constexpr int sideMargin = 180;
 constexpr int rightPanelWidth = 600; // Extra space on the right for music/hint
 */
 
-sf::Clock gameClock;   // Clock to track elapsed game time
-int moveCount{0};      // Number of moves made by the player
-bool gameWon = false;  // Flag indicating whether the puzzle has been solved
-int finalTime = 0;     // Time taken to win (in seconds or chosen unit)
-sf::Time winShownTime; // Duration for which the win screen/message is displayed
-
 std::string resourcePath()
 {
 #if defined(SFML_SYSTEM_MACOS) // macOS bundle: Resources inside Contents/Resources
@@ -49,6 +59,9 @@ std::string resourcePath()
 
     CFRelease(resourcesURL);
     return "";
+#elif defined(PUZZLE15_ASSET_DIR)
+    // Plain builds: the packed archive and pattern database generated in the build tree
+    return PUZZLE15_ASSET_DIR;
 #else
     // Other platforms: resources in executable directory
     return "assets/";
@@ -66,6 +79,8 @@ int main(int argc, char *argv[])
 #endif
 
 {
+    const FrameProfiler::Clock::time_point launchTime = FrameProfiler::Clock::now(); // for the startup report
+
 #if defined(SFML_SYSTEM_MACOS)
     constexpr float SCALE = 0.4f;
     constexpr float SCALEFONT = 0.6f; // FONT SCALE
@@ -88,168 +103,396 @@ int main(int argc, char *argv[])
     constexpr int sideMargin = static_cast<int>(180);
     constexpr int rightPanelWidth = static_cast<int>(600 * SCALE);
 
-    auto window = createWindow(N, tileSize, margin, headerHeight, topMargin, rightPanelWidth, bottomMargin);
-
-    // ===== Add background music =====
-    // auto music = loadBackgroundMusic("assets/musics/bg_music.mp3");
-
-    // auto clickSound = loadSound("assets/musics/pick.wav");
-    // auto winSound = loadSound("assets/musics/win.mp3");
-
-    auto music = loadBackgroundMusic(resourcePath() + "musics/bg_music.mp3");
-    auto clickSound = loadSound(resourcePath() + "musics/pick.wav");
-    auto winSound = loadSound(resourcePath() + "musics/win.mp3");
-
-    // Initial board configuration (classic 15 puzzle)
-    std::array<int, 16> board = {1, 2, 3, 4, 5, 6, 7, 8,
-                                 9, 10, 11, 12, 13, 14, 15, 0};
-
-    shuffleBoard(board); // Shuffle the board at start
+    constexpr unsigned int TITLE_FONT_SIZE = static_cast<unsigned int>(80 * SCALEFONT);  // for title text
+    constexpr unsigned int NUMBER_FONT_SIZE = static_cast<unsigned int>(80 * SCALEFONT); // for tile numbers
+    constexpr unsigned int INFO_FONT_SIZE = static_cast<unsigned int>(40 * SCALEFONT);   // for time and moves info
+    // constexpr unsigned int BUTTON_FONT_SIZE = static_cast<unsigned int>(80 * SCALEFONT); // for button text
+    constexpr unsigned int WIN_TEXT_SIZE = static_cast<unsigned int>(80 * SCALEFONT); // for "YOU WIN!"
+    constexpr unsigned int PROFILER_FONT_SIZE = static_cast<unsigned int>(22 * SCALEFONT);
+
+    // Decode fonts and sounds on worker threads while the window is created and shown;
+    // every glyph the game can draw is rasterized there too, so no frame pays for it later
+    AssetManager assets(resourcePath());
+    std::string printable;
+    for (char c = ' '; c <= '~'; ++c)
+        printable += c;
+    for (int size = 3; size <= 8; ++size)
+        assets.prewarmGlyphs(FontId::Number, "0123456789",
+                             static_cast<unsigned int>(NUMBER_FONT_SIZE * (static_cast<float>(DEFAULT_BOARD_SIZE) / size)));
+    assets.prewarmGlyphs(FontId::Title, "0123456789 PUZLEGAM", TITLE_FONT_SIZE, true);
+    assets.prewarmGlyphs(FontId::Title, " YOU WIN!", WIN_TEXT_SIZE, true);
+    assets.prewarmGlyphs(FontId::Info, printable, INFO_FONT_SIZE, true);                             // status, time, moves
+    assets.prewarmGlyphs(FontId::Info, printable, static_cast<unsigned int>(INFO_FONT_SIZE * 0.6f)); // key hints
+    assets.prewarmGlyphs(FontId::Info, printable, PROFILER_FONT_SIZE);                               // F3 overlay
+    assets.loadAsync();
+
+    auto window = createWindow(DEFAULT_BOARD_SIZE, tileSize, margin, headerHeight, topMargin, rightPanelWidth, bottomMargin);
+
+    // Optional solver tables, built offline by the pattern_db target; without them
+    // hints use the walking-distance table (well under 1 MB, built in memory)
+    PatternDatabase patternDB;
+    SolverOptions solverOptions;
+    solverOptions.heuristic = SolverHeuristic::WalkingDistance;
+    if (loadPatternDatabase(patternDB, resourcePath() + "pdb/puzzle15-663.pdb", solverOptions.heuristic))
+    {
+        solverOptions.heuristic = SolverHeuristic::PatternDatabase;
+        solverOptions.patterns = &patternDB;
+    }
 
-    std::map<std::string, sf::Font> fonts;
+    // Bounds learned by one hint search speed up the next; PUZZLE15_TT_MB sets the budget (0 = off)
+    const char *tableBudget = std::getenv("PUZZLE15_TT_MB");
+    const std::size_t tableMegabytes = tableBudget ? std::strtoull(tableBudget, nullptr, 10) : 16;
+    std::optional<TranspositionTable> transpositions;
+    if (tableMegabytes > 0)
+        solverOptions.transpositions = &transpositions.emplace(tableMegabytes << 20);
+
+    // Game rules run headless; PUZZLE15_SEED replays a known shuffle sequence
+    SteadyGameClock gameClock;
+    const char *seedText = std::getenv("PUZZLE15_SEED");
+    const std::uint64_t seed = seedText ? std::strtoull(seedText, nullptr, 10)
+                                        : (std::uint64_t(std::random_device{}()) << 32) | std::random_device{}();
+    GameState game(gameClock, seed);
+
+    // Set PUZZLE15_REPLAY_LOG to append this session's inputs to a replay file (see Puzzle15_replay)
+    const char *replayLog = std::getenv("PUZZLE15_REPLAY_LOG");
+    std::optional<ReplayWriter> recorder;
+    if (replayLog)
+    {
+        recorder.emplace(seed, gameClock.nowMilliseconds());
+        game.setRecorder(&*recorder);
+    }
 
-    // Font files used for different UI elements
-    // std::map<std::string, std::string> fontFiles = {
-    //     {"number", "assets/fonts/Montserrat-Bold.ttf"},
-    //     {"title", "assets/fonts/Poppins-Bold.ttf"},
-    //     {"info", "assets/fonts/Nunito-Regular.ttf"},
-    //     {"button", "assets/fonts/Quicksand-Bold.otf"}};
+    // Initial board configuration (classic 15 puzzle); 3-8 keys switch to other sizes
+    game.restart(DEFAULT_BOARD_SIZE);
+    const PuzzleBoard &board = game.board();
 
-    std::map<std::string, std::string> fontFiles = {
-        {"number", resourcePath() + "fonts/Montserrat-Bold.ttf"},
-        {"title", resourcePath() + "fonts/Poppins-Bold.ttf"},
-        {"info", resourcePath() + "fonts/Nunito-Regular.ttf"},
-        {"button", resourcePath() + "fonts/Quicksand-Bold.otf"}};
+    // Show the background and keep the window responsive until every asset is decoded
+    window.clear(sf::Color(180, 140, 200));
+    window.display();
+    while (!assets.ready() && window.isOpen())
+    {
+        if (auto event = window.waitEvent(sf::milliseconds(5)); event && event->is<sf::Event::Closed>())
+            window.close();
+    }
 
-    if (!loadFonts(fonts, fontFiles))
+    if (!assets.wait())
         return 1;
+    assets.report(std::cout);
+    if (!window.isOpen())
+        return 0;
+
+    // ===== Sound effects and background music (played from a worker thread) =====
+    SoundService sounds(assets);
+    sounds.setMusicEnabled(true);
+
+    // Title text, rebuilt only when the board size changes
+    sf::Text title(assets.font(FontId::Title), "", TITLE_FONT_SIZE);
+    title.setFillColor(sf::Color(128, 0, 128)); // purple color
+    title.setStyle(sf::Text::Bold);
+
+    // Right-side panel with elapsed time & move count (static texts laid out once)
+    InfoPanel infoPanel(assets.font(FontId::Info), margin + DEFAULT_BOARD_SIZE * tileSize, headerHeight + topMargin,
+                        rightMargin, gapRight, INFO_FONT_SIZE);
+
+    // Win overlay: semi-transparent backdrop and message, built once
+    sf::RectangleShape winOverlay(sf::Vector2f(window.getSize()));
+    winOverlay.setFillColor(sf::Color(0, 0, 0, 150));
+    sf::Text winText(assets.font(FontId::Title), " YOU WIN! ", WIN_TEXT_SIZE);
+    winText.setFillColor(sf::Color::Yellow);
+    winText.setStyle(sf::Text::Bold);
+    centerText(winText, 0, window.getSize().y / 2.f - 100, window.getSize().x, 200);
+
+    // Cached tile geometry; rebuilt only when the board size changes
+    // Scale tiles, corners and numbers so the grid keeps the 4x4 footprint
+    BoardRenderer boardRenderer(assets.font(FontId::Number));
+    auto layoutBoard = [&]()
+    {
+        const float boardScale = static_cast<float>(DEFAULT_BOARD_SIZE) / board.size();
+        boardRenderer.setLayout(board.size(), margin, headerHeight + topMargin,
+                                rectSize * boardScale, cornerRadius * boardScale,
+                                static_cast<unsigned int>(NUMBER_FONT_SIZE * boardScale));
+
+        title.setString(std::to_string(board.cellCount() - 1) + " PUZZLE GAME");
+        centerText(title, margin, topMargin, DEFAULT_BOARD_SIZE * tileSize, headerHeight);
+    };
+    layoutBoard();
+
+    // Set PUZZLE15_RENDER_COMPARE to time the per-tile drawBoard() path against the batched renderer
+    if (std::getenv("PUZZLE15_RENDER_COMPARE"))
+    {
+        for (int size = MIN_BOARD_SIZE; size <= MAX_BOARD_SIZE; ++size)
+        {
+            RandomEngine rng(size);
+            PuzzleBoard sample(size);
+            sample.shuffle(rng);
+            const float boardScale = static_cast<float>(DEFAULT_BOARD_SIZE) / size;
+            RenderComparison cmp = compareBoardRendering(sample, assets.font(FontId::Number), window.getSize(),
+                                                         margin, headerHeight, topMargin,
+                                                         rectSize * boardScale, cornerRadius * boardScale,
+                                                         static_cast<unsigned int>(NUMBER_FONT_SIZE * boardScale));
+            std::cout << size << "x" << size << " board, " << cmp.frames << " frames: drawBoard "
+                      << cmp.legacyMs << " ms/frame (" << cmp.legacyDrawCalls << " draw calls), batched "
+                      << cmp.batchedMs << " ms/frame (" << cmp.batchedDrawCalls << " draw calls), "
+                      << cmp.differingPixels << " differing pixels\n";
+        }
+    }
 
-    constexpr unsigned int TITLE_FONT_SIZE = static_cast<unsigned int>(80 * SCALEFONT);  // for title text
-    constexpr unsigned int NUMBER_FONT_SIZE = static_cast<unsigned int>(80 * SCALEFONT); // for tile numbers
-    constexpr unsigned int INFO_FONT_SIZE = static_cast<unsigned int>(40 * SCALEFONT);   // for time and moves info
-    // constexpr unsigned int BUTTON_FONT_SIZE = static_cast<unsigned int>(80 * SCALEFONT); // for button text
-    constexpr unsigned int WIN_TEXT_SIZE = static_cast<unsigned int>(80 * SCALEFONT); // for "YOU WIN!"
+    // Redraw only on input, timer seconds and overlays; PUZZLE15_FPS_CAP overrides the frame cap
+    constexpr unsigned int MAX_FPS = 60;
+    constexpr std::int32_t HINT_POLL_MS = 20;
+    const char *fpsCap = std::getenv("PUZZLE15_FPS_CAP");
+    FrameScheduler scheduler(fpsCap ? static_cast<unsigned int>(std::strtoul(fpsCap, nullptr, 10)) : MAX_FPS);
 
-    int emptyIdx = std::find(board.begin(), board.end(), 0) - board.begin(); // index of empty tile
-    bool musicPlaying = true;
+    // F3 shows frame-time percentiles, draw calls and section times; --trace <file> records a Chrome trace
+#ifdef _WIN32
+    const int argc = __argc;
+    char **argv = __argv;
+#endif
+    FrameProfiler profiler;
+    profiler.setLaunchTime(launchTime);
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--trace" && !profiler.openTrace(argv[i + 1]))
+            std::cerr << "Cannot create trace file " << argv[i + 1] << "\n";
+
+    bool showProfiler = false;
+    sf::String profilerString; // storage reused by setTextString()
+    sf::Text profilerText(assets.font(FontId::Info), "", PROFILER_FONT_SIZE);
+    profilerText.setFillColor(sf::Color::White);
+    profilerText.setPosition(sf::Vector2f(16.f, 12.f));
+    sf::RectangleShape profilerBackdrop;
+    profilerBackdrop.setFillColor(sf::Color(0, 0, 0, 170));
+    profilerBackdrop.setPosition(sf::Vector2f(8.f, 8.f));
+
+    // Scratch text of one frame; in PUZZLE15_TRACK_ALLOCS builds the profiler also counts heap allocations per frame
+    FrameArena frameArena;
+
+    // Start a new shuffled game, optionally with a different board size
+    auto restartGame = [&](int size)
+    {
+        AllocationSite site("restartGame");
+        const bool resized = size != board.size();
+        game.restart(size);
+        if (resized)
+            layoutBoard();
+    };
+
+    // Optimal next move, solved on a worker thread; H toggles the highlight
+    HintService hints(solverOptions);
+    hints.update(board);
+    bool showHint = false;
+
+    // Sounds, music and hints react to what the last input did to the game
+    bool winOverlayDone = false;
+    auto playGameEvents = [&]()
+    {
+        AllocationSite site("playGameEvents");
+        if (!game.events().empty())
+        {
+            AllocationSite hintSite("hints.update");
+            hints.update(board);
+        }
+
+        for (const GameEvent &event : game.events())
+        {
+            switch (event.type)
+            {
+            case GameEventType::Moved:
+                sounds.click();
+                break;
+
+            case GameEventType::Won:
+                sounds.win();
+                winOverlayDone = false;
+                break;
+
+            case GameEventType::Restarted:
+                sounds.endWin();
+                break;
+            }
+        }
+        game.clearEvents();
+    };
+    game.clearEvents(); // the initial shuffle has nothing to play
 
     while (window.isOpen())
     {
-        while (auto event = window.pollEvent())
+        // Sleeps until input arrives or the next frame is due
+        while (auto event = scheduler.waitEvent(window))
         {
+            ScopedZone eventZone(profiler, ProfileZone::Events);
+
             if (event->is<sf::Event::Closed>())
             {
                 window.close();
             }
 
+            else if (event->is<sf::Event::Resized>() || event->is<sf::Event::FocusGained>())
+            {
+                scheduler.invalidate(); // window contents may have been lost
+            }
+
             else if (auto *mouseButton = event->getIf<sf::Event::MouseButtonPressed>())
             {
-                // Calculate clicked tile position
-                int x = (mouseButton->position.x - margin) / tileSize;
-                int y = (mouseButton->position.y - headerHeight - topMargin) / tileSize;
+                // Calculate clicked tile position (tiles shrink so every size fills the 4x4 area)
+                const int n = board.size();
+                const float pitch = static_cast<float>(DEFAULT_BOARD_SIZE * tileSize) / n;
+                int x = static_cast<int>((mouseButton->position.x - margin) / pitch);
+                int y = static_cast<int>((mouseButton->position.y - headerHeight - topMargin) / pitch);
 
-                if (y >= 0 && y < N && x >= 0 && x < N)
+                if (y >= 0 && y < n && x >= 0 && x < n)
                 {
-                    tryMoveTile(board, emptyIdx, x, y, moveCount, clickSound, music, winSound, gameClock, gameWon, finalTime, winShownTime);
+                    scheduler.invalidate();
+                    game.tryMove(x, y);
                 }
             }
 
             else if (auto *keyPress = event->getIf<sf::Event::KeyPressed>())
             {
+                scheduler.invalidate();
+
                 if (keyPress->code == sf::Keyboard::Key::R)
                 {
-                    // Reset board
-                    board = {1, 2, 3, 4, 5, 6, 7, 8,
-                             9, 10, 11, 12, 13, 14, 15, 0};
-
-                    shuffleBoard(board);
-                    emptyIdx = std::find(board.begin(), board.end(), 0) - board.begin();
-                    moveCount = 0;
-                    gameClock.restart();
-                    gameWon = false;
-                    finalTime = 0;
-                    winShownTime = sf::Time::Zero;
+                    // Reset board (same size)
+                    restartGame(board.size());
+                }
+
+                // ===== Number keys 3-8 pick the 8-, 15-, 24-, 35-, 48- or 63-puzzle =====
+                else if (keyPress->code >= sf::Keyboard::Key::Num3 && keyPress->code <= sf::Keyboard::Key::Num8)
+                {
+                    restartGame(3 + static_cast<int>(keyPress->code) - static_cast<int>(sf::Keyboard::Key::Num3));
+                }
+
+                else if (keyPress->code == sf::Keyboard::Key::H)
+                {
+                    showHint = !showHint;
+                }
+
+                else if (keyPress->code == sf::Keyboard::Key::F3)
+                {
+                    showProfiler = !showProfiler;
                 }
 
                 // ===== Add shortcut key to toggle music =====
                 else if (keyPress->code == sf::Keyboard::Key::M)
                 {
-                    if (musicPlaying)
-                    {
-                        musicPlaying = false;
-                        music.pause();
-                    }
-                    else
-                    {
-                        music.play();
-                        musicPlaying = true;
-                    }
+                    sounds.setMusicEnabled(!sounds.musicEnabled());
                 }
 
-                int ex = emptyIdx % N;
-                int ey = emptyIdx / N;
+                const int n = board.size();
+                int ex = board.emptyIdx() % n;
+                int ey = board.emptyIdx() / n;
 
-                if (keyPress->code == sf::Keyboard::Key::Up && ey < N - 1)
-                    tryMoveTile(board, emptyIdx, ex, ey + 1, moveCount, clickSound, music, winSound, gameClock, gameWon, finalTime, winShownTime);
+                if (keyPress->code == sf::Keyboard::Key::Up && ey < n - 1)
+                    game.tryMove(ex, ey + 1);
 
                 else if (keyPress->code == sf::Keyboard::Key::Down && ey > 0)
-                    tryMoveTile(board, emptyIdx, ex, ey - 1, moveCount, clickSound, music, winSound, gameClock, gameWon, finalTime, winShownTime);
+                    game.tryMove(ex, ey - 1);
 
-                else if (keyPress->code == sf::Keyboard::Key::Left && ex < N - 1)
-                    tryMoveTile(board, emptyIdx, ex + 1, ey, moveCount, clickSound, music, winSound, gameClock, gameWon, finalTime, winShownTime);
+                else if (keyPress->code == sf::Keyboard::Key::Left && ex < n - 1)
+                    game.tryMove(ex + 1, ey);
 
                 else if (keyPress->code == sf::Keyboard::Key::Right && ex > 0)
-                    tryMoveTile(board, emptyIdx, ex - 1, ey, moveCount, clickSound, music, winSound, gameClock, gameWon, finalTime, winShownTime);
+                    game.tryMove(ex - 1, ey);
             }
+
+            playGameEvents();
         }
 
+        if (!window.isOpen())
+            break;
+
+        // Nothing visible changed: go back to waiting for events
+        if (!scheduler.beginFrame())
+            continue;
+        profiler.beginFrame();
+        frameArena.reset();
+
         // window.clear(sf::Color::White);
         window.clear(sf::Color(180, 140, 200)); // light purple background
 
-        // Draw title
-        sf::Text title(fonts["title"], "15 PUZZLE GAME", TITLE_FONT_SIZE);
-        title.setFillColor(sf::Color(128, 0, 128)); // purple color
-        title.setStyle(sf::Text::Bold);
-        centerText(title, margin, topMargin, N * tileSize, headerHeight);
-        window.draw(title);
+        {
+            ScopedZone zone(profiler, ProfileZone::DrawUI);
 
-        // ===== Display elapsed time & move count =====
-        int elapsedSeconds = static_cast<int>(gameClock.getElapsedTime().asSeconds());
+            // Draw title
+            window.draw(title);
 
-        float RightX = margin + N * tileSize;
-        float TopY = headerHeight + topMargin;
+            // ===== Display elapsed time & move count =====
+            infoPanel.update(sounds.musicEnabled(), game.elapsedSeconds(), game.moveCount());
+            infoPanel.draw(window);
+            profiler.addDrawCalls(1 + InfoPanel::DRAW_CALLS);
+        }
 
-        drawUI(window, fonts["info"], musicPlaying, elapsedSeconds, finalTime, gameWon, moveCount, RightX, TopY, rightMargin, gapRight, INFO_FONT_SIZE);
+        {
+            ScopedZone zone(profiler, ProfileZone::DrawBoard);
 
-        drawBoard(window, board, fonts["number"], margin, headerHeight, topMargin, rectSize, cornerRadius, NUMBER_FONT_SIZE);
+            // Patch only the tiles that moved, then draw the grid in two draw calls
+            boardRenderer.update(board);
+            boardRenderer.setHighlight(showHint ? hints.hint().cell : -1);
+            boardRenderer.draw(window);
+            profiler.addDrawCalls(BoardRenderer::DRAW_CALLS);
+        }
+
+        // The hint appears as soon as the worker publishes it
+        if (showHint && hints.pending())
+            scheduler.redrawIn(sf::milliseconds(HINT_POLL_MS));
 
-        if (gameWon)
+        constexpr std::uint64_t WIN_OVERLAY_MS = 3000;
+        if (game.won() && !winOverlayDone)
         {
-            if (gameClock.getElapsedTime() - winShownTime < sf::seconds(3))
+            ScopedZone zone(profiler, ProfileZone::WinOverlay);
+            if (const std::uint64_t sinceWin = game.millisecondsSinceWin(); sinceWin < WIN_OVERLAY_MS)
             {
                 // Show semi-transparent overlay for win message
-                sf::RectangleShape won(sf::Vector2f(window.getSize()));
-                won.setFillColor(sf::Color(0, 0, 0, 150));
-                window.draw(won);
-
-                sf::Text winText(fonts["title"], " YOU WIN! ", WIN_TEXT_SIZE);
-                winText.setFillColor(sf::Color::Yellow);
-                winText.setStyle(sf::Text::Bold);
-                centerText(winText, 0, window.getSize().y / 2.f - 100, window.getSize().x, 200);
+                window.draw(winOverlay);
                 window.draw(winText);
+                profiler.addDrawCalls(2);
+
+                // Redraw once more when the overlay expires
+                scheduler.redrawIn(sf::milliseconds(static_cast<std::int32_t>(WIN_OVERLAY_MS - sinceWin)));
             }
             else
             {
-                // Overlay expired, stop win sound and resume background music
-                if (winSound)
-                    winSound->stop();
-
-                music.play();
+                // Overlay expired, stop win sound and resume background music (once)
+                sounds.endWin();
+                winOverlayDone = true;
             }
         }
 
-        window.display();
+        // Statistics up to the previous frame (this one is still being drawn)
+        if (showProfiler)
+        {
+            std::pmr::string overlay(&frameArena);
+            profiler.formatOverlay(overlay);
+            setTextString(profilerText, profilerString, overlay);
+            const sf::FloatRect bounds = profilerText.getGlobalBounds();
+            profilerBackdrop.setSize(sf::Vector2f(bounds.position.x + bounds.size.x + 8.f, bounds.position.y + bounds.size.y + 8.f) -
+                                     profilerBackdrop.getPosition());
+            window.draw(profilerBackdrop);
+            window.draw(profilerText);
+            profiler.addDrawCalls(2);
+        }
+
+        {
+            ScopedZone zone(profiler, ProfileZone::Display);
+            window.display();
+        }
+        profiler.endFrame();
+
+        // The timer text changes at the next whole second
+        if (!game.won())
+            scheduler.redrawIn(sf::milliseconds(static_cast<std::int32_t>(1000 - game.elapsedMilliseconds() % 1000)));
+    }
+
+    if (recorder)
+    {
+        recorder->end(gameClock.nowMilliseconds());
+        if (!recorder->appendTo(replayLog))
+            std::cerr << "Failed to write replay log " << replayLog << "\n";
     }
 
-    music.stop(); // Stop background music when window closes
+    scheduler.report(std::cout);
+    profiler.report(std::cout);
+    reportAllocationSites(std::cout);
+    hints.report(std::cout);
+    sounds.report(std::cout); // the music stops with the service
 }
@@ -0,0 +1,176 @@
+#include "mappedFile.hh"
+
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#define PSAPI_VERSION 2 // K32* entry points live in kernel32, no psapi.lib needed
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#if defined(_WIN32)
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+/**
+ * Map a file read-only into the address space.
+ *
+ * Empty files cannot be mapped and are reported as failures.
+ *
+ * @param path File to map.
+ * @return true on success.
+ */
+bool MappedFile::open(const std::string &path)
+{
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const unsigned char *>(view);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps its own reference to the file
+    if (view == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const unsigned char *>(view);
+    m_size = static_cast<std::size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (!m_data)
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    CloseHandle(static_cast<HANDLE>(m_file));
+    m_file = nullptr;
+    m_mapping = nullptr;
+#else
+    munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+/**
+ * Count the mapped pages that are currently in physical memory.
+ *
+ * Uses mincore() on POSIX and QueryWorkingSetEx() on Windows.
+ *
+ * @return Resident size in bytes (page granularity), 0 if unknown.
+ */
+std::size_t MappedFile::residentBytes() const
+{
+    if (!m_data)
+        return 0;
+
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const std::size_t page = info.dwPageSize;
+    const std::size_t pages = (m_size + page - 1) / page;
+
+    std::vector<PSAPI_WORKING_SET_EX_INFORMATION> query(pages);
+    for (std::size_t i = 0; i < pages; ++i)
+        query[i].VirtualAddress = const_cast<unsigned char *>(m_data) + i * page;
+
+    if (!QueryWorkingSetEx(GetCurrentProcess(), query.data(),
+                           static_cast<DWORD>(query.size() * sizeof(query[0]))))
+        return 0;
+
+    std::size_t resident = 0;
+    for (const auto &entry : query)
+        if (entry.VirtualAttributes.Valid)
+            resident += page;
+    return resident;
+#else
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t pages = (m_size + page - 1) / page;
+
+#if defined(__APPLE__)
+    std::vector<char> vec(pages);
+#else
+    std::vector<unsigned char> vec(pages);
+#endif
+    if (mincore(const_cast<unsigned char *>(m_data), m_size, vec.data()) != 0)
+        return 0;
+
+    std::size_t resident = 0;
+    for (auto v : vec)
+        if (v & 1)
+            resident += page;
+    return resident;
+#endif
+}
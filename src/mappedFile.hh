@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The mapping stays valid for the lifetime of the object, so data() can be
+ * handed to code that reads lazily (tables, streamed assets) without copying.
+ * Pages are loaded by the OS on first touch.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    // Map the file at path; returns false (and stays closed) on failure
+    bool open(const std::string &path);
+
+    // Unmap the file (no-op if nothing is mapped)
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const unsigned char *data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+    // Number of bytes of the mapping currently resident in physical memory
+    std::size_t residentBytes() const;
+
+private:
+    const unsigned char *m_data = nullptr;
+    std::size_t m_size = 0;
+#if defined(_WIN32)
+    void *m_file = nullptr;    // HANDLE of the opened file
+    void *m_mapping = nullptr; // HANDLE of the file mapping object
+#endif
+};
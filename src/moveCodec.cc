@@ -0,0 +1,172 @@
+#include "moveCodec.hh"
+#include "board.hh"
+
+#include <cstring>
+
+namespace
+{
+    constexpr char MOVE_MAGIC[2] = {'M', 'V'};
+    constexpr int DX[4] = {0, 0, -1, 1}; // indexed by BlankDirection
+    constexpr int DY[4] = {-1, 1, 0, 0};
+
+    // Tiles form a permutation of 0..cells-1; returns the blank cell or -1
+    template <typename T>
+    int findBlank(std::span<const T> tiles, int cells)
+    {
+        if (static_cast<int>(tiles.size()) != cells)
+            return -1;
+        std::uint64_t seen = 0;
+        int blank = -1;
+        for (int cell = 0; cell < cells; ++cell)
+        {
+            const int value = static_cast<int>(tiles[cell]);
+            if (value < 0 || value >= cells || (seen >> value) & 1)
+                return -1;
+            seen |= std::uint64_t(1) << value;
+            if (value == 0)
+                blank = cell;
+        }
+        return blank;
+    }
+
+    template <int N>
+    MoveCheck replay(const MoveRecordReader &record)
+    {
+        MoveCheck check;
+        check.moves = record.moveCount();
+
+        Board<N> board;
+        const std::span<const unsigned char> start = record.startTiles();
+        board.emptyIdx = findBlank(start, N * N);
+        if (board.emptyIdx < 0)
+            return check;
+        for (int cell = 0; cell < N * N; ++cell)
+            board.tiles[cell] = start[cell];
+
+        const std::span<const unsigned char> packed = record.packedMoves();
+        for (std::uint32_t i = 0; i < check.moves; ++i)
+        {
+            const int direction = (packed[i / 4] >> (2 * (i % 4))) & 3;
+            if (!moveTile(board, board.emptyIdx % N + DX[direction], board.emptyIdx / N + DY[direction]))
+            {
+                check.firstIllegal = static_cast<int>(i);
+                return check;
+            }
+        }
+        check.valid = true;
+        check.solved = isSolved(board);
+        return check;
+    }
+}
+
+bool encodeMoves(int size, std::span<const int> start, std::span<const int> blankTargets,
+                 std::vector<unsigned char> &out)
+{
+    if (size < MIN_BOARD_SIZE || size > MAX_BOARD_SIZE)
+        return false;
+    int blank = findBlank(start, size * size);
+    if (blank < 0)
+        return false;
+
+    MoveRecordHeader header{};
+    std::memcpy(header.magic, MOVE_MAGIC, sizeof(MOVE_MAGIC));
+    header.version = MOVE_RECORD_VERSION;
+    header.size = static_cast<std::uint8_t>(size);
+    header.moveCount = static_cast<std::uint32_t>(blankTargets.size());
+
+    const std::size_t first = out.size();
+    out.resize(first + sizeof(header) + start.size() + (blankTargets.size() + 3) / 4);
+    unsigned char *bytes = out.data() + first;
+    std::memcpy(bytes, &header, sizeof(header));
+    for (std::size_t cell = 0; cell < start.size(); ++cell)
+        bytes[sizeof(header) + cell] = static_cast<unsigned char>(start[cell]);
+
+    unsigned char *moves = bytes + sizeof(header) + start.size();
+    for (std::size_t i = 0; i < blankTargets.size(); ++i)
+    {
+        const int target = blankTargets[i];
+        int direction;
+        if (target == blank - size)
+            direction = static_cast<int>(BlankDirection::Up);
+        else if (target == blank + size)
+            direction = static_cast<int>(BlankDirection::Down);
+        else if (target == blank - 1 && blank % size != 0)
+            direction = static_cast<int>(BlankDirection::Left);
+        else if (target == blank + 1 && target % size != 0)
+            direction = static_cast<int>(BlankDirection::Right);
+        else
+            direction = -1;
+
+        if (direction < 0 || target < 0 || target >= size * size)
+        {
+            out.resize(first);
+            return false;
+        }
+        moves[i / 4] = static_cast<unsigned char>(moves[i / 4] | (direction << (2 * (i % 4))));
+        blank = target;
+    }
+    return true;
+}
+
+bool MoveRecordReader::open(std::span<const unsigned char> data)
+{
+    if (data.size() < sizeof(MoveRecordHeader))
+        return false;
+    std::memcpy(&m_header, data.data(), sizeof(m_header));
+    if (std::memcmp(m_header.magic, MOVE_MAGIC, sizeof(MOVE_MAGIC)) != 0 || m_header.version != MOVE_RECORD_VERSION ||
+        m_header.size < MIN_BOARD_SIZE || m_header.size > MAX_BOARD_SIZE)
+        return false;
+
+    const std::size_t cells = std::size_t(m_header.size) * m_header.size;
+    const std::size_t moveBytes = (std::size_t(m_header.moveCount) + 3) / 4;
+    if (data.size() - sizeof(MoveRecordHeader) < cells + moveBytes)
+        return false;
+
+    m_tiles = data.subspan(sizeof(MoveRecordHeader), cells);
+    m_moves = data.subspan(sizeof(MoveRecordHeader) + cells, moveBytes);
+    return true;
+}
+
+std::size_t MoveRecordReader::recordBytes() const
+{
+    return sizeof(MoveRecordHeader) + m_tiles.size() + m_moves.size();
+}
+
+std::vector<int> MoveRecordReader::blankTargets() const
+{
+    std::vector<int> targets;
+    const int size = m_header.size;
+    int blank = findBlank(m_tiles, size * size);
+    if (blank < 0)
+        return targets;
+
+    targets.reserve(m_header.moveCount);
+    for (std::uint32_t i = 0; i < m_header.moveCount; ++i)
+    {
+        const int direction = static_cast<int>(move(i));
+        blank += DX[direction] + DY[direction] * size; // not range-checked: see validateMoves()
+        targets.push_back(blank);
+    }
+    return targets;
+}
+
+MoveCheck validateMoves(const MoveRecordReader &record)
+{
+    switch (record.size())
+    {
+    case 3:
+        return replay<3>(record);
+    case 4:
+        return replay<4>(record);
+    case 5:
+        return replay<5>(record);
+    case 6:
+        return replay<6>(record);
+    case 7:
+        return replay<7>(record);
+    case 8:
+        return replay<8>(record);
+    default:
+        return {};
+    }
+}
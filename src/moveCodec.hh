@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Record layout: MoveRecordHeader, size * size start tiles (one byte per cell,
+// row-major, 0 = blank), then ceil(moveCount / 4) bytes of moves, four per byte
+// starting at the low bits. A move is the direction the blank travels (see
+// BlankDirection). A 55-move 4x4 solution takes 38 bytes. Records can be
+// concatenated in one file.
+constexpr std::uint8_t MOVE_RECORD_VERSION = 1;
+
+enum class BlankDirection : std::uint8_t
+{
+    Up,
+    Down,
+    Left,
+    Right
+};
+
+struct MoveRecordHeader
+{
+    char magic[2]; // "MV"
+    std::uint8_t version;
+    std::uint8_t size; // board dimension (3..8)
+    std::uint32_t moveCount;
+};
+
+/**
+ * Append one move sequence to a buffer of records.
+ *
+ * @param size         Board dimension (3..8).
+ * @param start        Start position, size * size tiles (0 = blank).
+ * @param blankTargets Cells the blank moves to, in order (as in SolverResult::moves).
+ * @param out          Receives the record at its end.
+ * @return false (out unchanged) if start is not a permutation of that size
+ *         or a target is not next to the blank.
+ */
+bool encodeMoves(int size, std::span<const int> start, std::span<const int> blankTargets,
+                 std::vector<unsigned char> &out);
+
+// Decoder of one record (no copy; the bytes must outlive the reader)
+class MoveRecordReader
+{
+public:
+    // Parse the record at the start of data; false if it is not one or is truncated
+    bool open(std::span<const unsigned char> data);
+
+    const MoveRecordHeader &header() const { return m_header; }
+    int size() const { return m_header.size; }
+    std::uint32_t moveCount() const { return m_header.moveCount; }
+
+    std::span<const unsigned char> startTiles() const { return m_tiles; }
+    std::span<const unsigned char> packedMoves() const { return m_moves; }
+
+    BlankDirection move(std::uint32_t index) const
+    {
+        return static_cast<BlankDirection>((m_moves[index / 4] >> (2 * (index % 4))) & 3);
+    }
+
+    // Bytes taken by this record, to step to the next one
+    std::size_t recordBytes() const;
+
+    // Cells the blank moves to, in order (empty if the start has no blank)
+    std::vector<int> blankTargets() const;
+
+private:
+    MoveRecordHeader m_header{};
+    std::span<const unsigned char> m_tiles;
+    std::span<const unsigned char> m_moves;
+};
+
+// Outcome of replaying one record
+struct MoveCheck
+{
+    bool valid = false;     // start is a permutation and every move stays on the board
+    bool solved = false;    // the last move leaves the goal position
+    int firstIllegal = -1;  // index of the first move that leaves the board
+    std::uint32_t moves = 0;
+};
+
+/**
+ * Replay a record with the game's moveTile() rules and check the result.
+ *
+ * Each move is decoded to the tile next to the blank and applied through
+ * moveTile() on a Board<N> of the record's size, so a sequence passes
+ * exactly when clicking those tiles in the game would solve the puzzle.
+ *
+ * @param record Opened record.
+ * @return Legality, final isSolved() and the first offending move.
+ */
+MoveCheck validateMoves(const MoveRecordReader &record);
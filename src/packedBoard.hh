@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * 4x4 board packed into one 64-bit word, 4 bits per cell.
+ *
+ * Cell i (row-major, same indexing as std::array<int, 16>) lives in bits
+ * [4i, 4i + 4). The empty tile is the nibble 0, so a move is a single
+ * shift-and-mask, the solved check is one compare, and a state fits in a
+ * register and can be hashed with a couple of multiplies.
+ */
+using PackedBoard = std::uint64_t;
+
+constexpr int PACKED_SIDE = 4;
+constexpr int PACKED_CELLS = 16;
+
+// Tile value (0 = empty) stored on a cell
+constexpr int packedTile(PackedBoard board, int cell)
+{
+    return static_cast<int>((board >> (cell * 4)) & 0xF);
+}
+
+// Convert from the array form used by the game and renderer
+constexpr PackedBoard packBoard(const std::array<int, 16> &board)
+{
+    PackedBoard packed = 0;
+    for (int i = 0; i < PACKED_CELLS; ++i)
+        packed |= static_cast<PackedBoard>(board[i] & 0xF) << (i * 4);
+    return packed;
+}
+
+// Convert back to the array form (e.g. for drawBoard)
+constexpr std::array<int, 16> unpackBoard(PackedBoard packed)
+{
+    std::array<int, 16> board{};
+    for (int i = 0; i < PACKED_CELLS; ++i)
+        board[i] = packedTile(packed, i);
+    return board;
+}
+
+// Solved state: tiles 1–15 in order, empty tile on the last cell
+constexpr PackedBoard PACKED_SOLVED = packBoard({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0});
+
+constexpr bool isSolvedPacked(PackedBoard board) { return board == PACKED_SOLVED; }
+
+/**
+ * Compile-time neighbor table: for every empty-tile cell, the cells whose
+ * tile can slide into it, plus the same set as a bit mask for O(1)
+ * adjacency checks.
+ */
+struct PackedMoveTable
+{
+    std::uint8_t count[PACKED_CELLS];      // number of neighbors (2–4)
+    std::uint8_t target[PACKED_CELLS][4];  // neighbor cells: up, left, right, down
+    std::uint16_t adjacent[PACKED_CELLS];  // bit j set if cell j is a neighbor
+};
+
+constexpr PackedMoveTable makePackedMoveTable()
+{
+    PackedMoveTable t{};
+    for (int i = 0; i < PACKED_CELLS; ++i)
+    {
+        const int x = i % PACKED_SIDE, y = i / PACKED_SIDE;
+        int n = 0;
+        auto add = [&](int cell)
+        {
+            t.target[i][n++] = static_cast<std::uint8_t>(cell);
+            t.adjacent[i] = static_cast<std::uint16_t>(t.adjacent[i] | (1u << cell));
+        };
+        if (y > 0)
+            add(i - PACKED_SIDE);
+        if (x > 0)
+            add(i - 1);
+        if (x < PACKED_SIDE - 1)
+            add(i + 1);
+        if (y < PACKED_SIDE - 1)
+            add(i + PACKED_SIDE);
+        t.count[i] = static_cast<std::uint8_t>(n);
+    }
+    return t;
+}
+
+constexpr PackedMoveTable PACKED_MOVES = makePackedMoveTable();
+
+// True if the tile on cell target can slide into the empty cell
+constexpr bool isAdjacentCell(int emptyIdx, int target)
+{
+    return (PACKED_MOVES.adjacent[emptyIdx] >> target) & 1u;
+}
+
+/**
+ * Slide the tile on cell target into the empty cell emptyIdx.
+ * The caller guarantees adjacency; the empty nibble is 0, so the tile is
+ * simply cleared from its cell and OR-ed into the empty one.
+ */
+constexpr PackedBoard slideTile(PackedBoard board, int emptyIdx, int target)
+{
+    const PackedBoard tile = (board >> (target * 4)) & 0xF;
+    return (board & ~(PackedBoard{0xF} << (target * 4))) | (tile << (emptyIdx * 4));
+}
+
+// Cheap well-mixed hash of a packed board (64-bit finalizer from MurmurHash3)
+constexpr std::uint64_t hashPackedBoard(PackedBoard board)
+{
+    board ^= board >> 33;
+    board *= 0xff51afd7ed558ccdULL;
+    board ^= board >> 33;
+    board *= 0xc4ceb9fe1a85ec53ULL;
+    board ^= board >> 33;
+    return board;
+}
+
+static_assert(unpackBoard(PACKED_SOLVED)[14] == 15 && unpackBoard(PACKED_SOLVED)[15] == 0);
+static_assert(slideTile(PACKED_SOLVED, 15, 14) == packBoard({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 0, 15}));
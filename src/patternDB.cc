@@ -0,0 +1,332 @@
+#include "patternDB.hh"
+#include "permutationRank.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+
+namespace
+{
+    constexpr int CELLS = 16;
+    constexpr char PDB_MAGIC[8] = {'P', '1', '5', 'P', 'D', 'B', '\0', '\0'};
+    constexpr std::uint8_t UNSEEN = 0xFF;
+
+    // Number of ordered placements of k tiles on 16 cells: 16! / (16 - k)!
+    std::uint64_t tableSize(int k)
+    {
+        return permutationCount(CELLS, k);
+    }
+
+    // Rank of an ordered placement of k distinct cells (see permutationRank.hh)
+    std::uint64_t rankCells(const int *cells, int k)
+    {
+        return rankPartial(cells, k, CELLS);
+    }
+
+    void unrankCells(std::uint64_t index, int k, int *cells)
+    {
+        unrankPartial(index, k, CELLS, cells);
+    }
+
+    // Cell neighbors of every board index (-1 terminated)
+    struct NeighborTable
+    {
+        int cells[CELLS][5];
+    };
+
+    constexpr NeighborTable makeNeighborTable()
+    {
+        NeighborTable t{};
+        for (int i = 0; i < CELLS; ++i)
+        {
+            int x = i % 4, y = i / 4, n = 0;
+            if (y > 0)
+                t.cells[i][n++] = i - 4;
+            if (x > 0)
+                t.cells[i][n++] = i - 1;
+            if (x < 3)
+                t.cells[i][n++] = i + 1;
+            if (y < 3)
+                t.cells[i][n++] = i + 4;
+            for (; n < 5; ++n)
+                t.cells[i][n] = -1;
+        }
+        return t;
+    }
+
+    constexpr NeighborTable NEIGHBORS = makeNeighborTable();
+
+    /*
+     * 0-1 BFS over (pattern placement, blank cell) states.
+     * State id = placement rank * 16 + blank cell.
+     */
+    std::vector<std::uint8_t> buildPatternTable(const std::vector<int> &tiles, std::ostream &log)
+    {
+        const int k = static_cast<int>(tiles.size());
+        const std::uint64_t entries = tableSize(k);
+        const std::uint64_t states = entries * CELLS;
+
+        std::vector<std::uint8_t> dist(states, UNSEEN);
+        std::vector<std::uint64_t> queued((states + 63) / 64, 0);
+        std::vector<std::uint64_t> layer, next;
+
+        int goal[PDB_MAX_PATTERN_TILES];
+        for (int i = 0; i < k; ++i)
+            goal[i] = tiles[i] - 1;
+        const std::uint64_t start = rankCells(goal, k) * CELLS + (CELLS - 1);
+        dist[start] = 0;
+        layer.push_back(start);
+
+        std::uint64_t visited = 0;
+        for (int depth = 0; !layer.empty(); ++depth)
+        {
+            // Expand the layer; free blank moves stay in it (used as a stack)
+            while (!layer.empty())
+            {
+                const std::uint64_t state = layer.back();
+                layer.pop_back();
+                ++visited;
+
+                const std::uint64_t rank = state / CELLS;
+                const int blank = static_cast<int>(state % CELLS);
+
+                int cells[PDB_MAX_PATTERN_TILES];
+                unrankCells(rank, k, cells);
+                int slotAt[CELLS];
+                std::fill(slotAt, slotAt + CELLS, -1);
+                for (int i = 0; i < k; ++i)
+                    slotAt[cells[i]] = i;
+
+                for (const int nb : NEIGHBORS.cells[blank])
+                {
+                    if (nb < 0)
+                        break;
+
+                    const int slot = slotAt[nb];
+                    if (slot < 0)
+                    {
+                        // Foreign tile moves: same placement, no cost
+                        const std::uint64_t n = rank * CELLS + static_cast<std::uint64_t>(nb);
+                        if (dist[n] == UNSEEN)
+                        {
+                            dist[n] = static_cast<std::uint8_t>(depth);
+                            layer.push_back(n);
+                        }
+                    }
+                    else
+                    {
+                        // Pattern tile slides into the blank: costs one move
+                        cells[slot] = blank;
+                        const std::uint64_t n = rankCells(cells, k) * CELLS + static_cast<std::uint64_t>(nb);
+                        cells[slot] = nb;
+
+                        const std::uint64_t bit = 1ull << (n % 64);
+                        if (dist[n] == UNSEEN && !(queued[n / 64] & bit))
+                        {
+                            queued[n / 64] |= bit;
+                            next.push_back(n);
+                        }
+                    }
+                }
+            }
+
+            for (const std::uint64_t n : next)
+                if (dist[n] == UNSEEN)
+                {
+                    dist[n] = static_cast<std::uint8_t>(depth + 1);
+                    layer.push_back(n);
+                }
+            next.clear();
+        }
+
+        // Collapse the blank dimension: the estimate must hold for any blank cell
+        std::vector<std::uint8_t> table(entries, UNSEEN);
+        int maxValue = 0;
+        for (std::uint64_t rank = 0; rank < entries; ++rank)
+        {
+            std::uint8_t best = UNSEEN;
+            for (int blank = 0; blank < CELLS; ++blank)
+                best = std::min(best, dist[rank * CELLS + static_cast<std::uint64_t>(blank)]);
+            table[rank] = best;
+            maxValue = std::max(maxValue, static_cast<int>(best));
+        }
+
+        log << "  " << k << "-tile pattern: " << entries << " entries, "
+            << visited << " states visited, max cost " << maxValue << "\n";
+        return table;
+    }
+}
+
+std::vector<std::vector<int>> defaultPartition663()
+{
+    return {{1, 5, 6, 9, 10, 13}, {7, 8, 11, 12, 14, 15}, {2, 3, 4}};
+}
+
+std::vector<std::vector<int>> defaultPartition78()
+{
+    return {{1, 2, 3, 4, 5, 6, 7, 8}, {9, 10, 11, 12, 13, 14, 15}};
+}
+
+/**
+ * Map a database file and validate its header.
+ *
+ * @param path Database file written by generatePatternDatabase().
+ * @return true if the file is a valid database for this version.
+ */
+bool PatternDatabase::load(const std::string &path)
+{
+    m_patternCount = 0;
+    m_patternOf.fill(-1);
+    if (!m_file.open(path) || m_file.size() < sizeof(PdbFileHeader))
+        return false;
+
+    PdbFileHeader header;
+    std::memcpy(&header, m_file.data(), sizeof(header));
+    if (std::memcmp(header.magic, PDB_MAGIC, sizeof(PDB_MAGIC)) != 0 ||
+        header.version != PDB_FORMAT_VERSION ||
+        header.patternCount == 0 || header.patternCount > PDB_MAX_PATTERNS)
+    {
+        m_file.close();
+        return false;
+    }
+
+    std::array<int, 16> owner;
+    owner.fill(-1);
+    for (std::uint32_t p = 0; p < header.patternCount; ++p)
+    {
+        const PdbPatternInfo &info = header.patterns[p];
+        bool valid = info.tileCount >= 1 && info.tileCount <= PDB_MAX_PATTERN_TILES &&
+                     info.entries == tableSize(static_cast<int>(info.tileCount)) &&
+                     info.offset + info.entries <= m_file.size();
+
+        Pattern &pattern = m_patterns[p];
+        pattern.tiles.clear();
+        for (std::uint32_t i = 0; valid && i < info.tileCount; ++i)
+        {
+            const int tile = info.tiles[i];
+            valid = tile >= 1 && tile < CELLS && owner[tile] < 0;
+            if (valid)
+            {
+                owner[tile] = static_cast<int>(p);
+                pattern.tiles.push_back(tile);
+            }
+        }
+
+        if (!valid)
+        {
+            m_file.close();
+            return false;
+        }
+
+        pattern.table = m_file.data() + info.offset;
+        pattern.entries = info.entries;
+    }
+
+    m_patternOf = owner;
+    m_patternCount = static_cast<int>(header.patternCount);
+    return true;
+}
+
+std::uint64_t PatternDatabase::patternIndex(int pattern, const std::array<int, 16> &tileCell) const
+{
+    const Pattern &p = m_patterns[pattern];
+    int cells[PDB_MAX_PATTERN_TILES];
+    const int k = static_cast<int>(p.tiles.size());
+    for (int i = 0; i < k; ++i)
+        cells[i] = tileCell[p.tiles[i]];
+    return rankCells(cells, k);
+}
+
+int PatternDatabase::estimate(const std::array<int, 16> &board) const
+{
+    std::array<int, 16> tileCell{};
+    for (int cell = 0; cell < CELLS; ++cell)
+        tileCell[board[cell]] = cell;
+
+    int sum = 0;
+    for (int p = 0; p < m_patternCount; ++p)
+        sum += lookup(p, patternIndex(p, tileCell));
+    return sum;
+}
+
+std::string PatternDatabase::describe() const
+{
+    std::string text;
+    for (int p = 0; p < m_patternCount; ++p)
+    {
+        if (p)
+            text += "-";
+        text += std::to_string(m_patterns[p].tiles.size());
+    }
+    return text;
+}
+
+bool generatePatternDatabase(const std::vector<std::vector<int>> &partition,
+                             const std::string &path, std::ostream &log)
+{
+    if (partition.empty() || partition.size() > PDB_MAX_PATTERNS)
+    {
+        log << "A partition needs 1 to " << PDB_MAX_PATTERNS << " patterns\n";
+        return false;
+    }
+
+    PdbFileHeader header{};
+    std::memcpy(header.magic, PDB_MAGIC, sizeof(PDB_MAGIC));
+    header.version = PDB_FORMAT_VERSION;
+    header.patternCount = static_cast<std::uint32_t>(partition.size());
+
+    std::array<bool, 16> taken{};
+    std::uint64_t offset = (sizeof(PdbFileHeader) + 63) & ~std::uint64_t{63};
+    for (std::size_t p = 0; p < partition.size(); ++p)
+    {
+        const auto &tiles = partition[p];
+        if (tiles.empty() || tiles.size() > PDB_MAX_PATTERN_TILES)
+        {
+            log << "Pattern " << p << " must have 1 to " << PDB_MAX_PATTERN_TILES << " tiles\n";
+            return false;
+        }
+
+        PdbPatternInfo &info = header.patterns[p];
+        info.tileCount = static_cast<std::uint32_t>(tiles.size());
+        for (std::size_t i = 0; i < tiles.size(); ++i)
+        {
+            const int tile = tiles[i];
+            if (tile < 1 || tile >= CELLS || taken[tile])
+            {
+                log << "Invalid or repeated tile " << tile << " in pattern " << p << "\n";
+                return false;
+            }
+            taken[tile] = true;
+            info.tiles[i] = static_cast<std::uint8_t>(tile);
+        }
+        info.entries = tableSize(static_cast<int>(tiles.size()));
+        info.offset = offset;
+        offset = (offset + info.entries + 63) & ~std::uint64_t{63};
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        log << "Cannot write " << path << "\n";
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (std::size_t p = 0; p < partition.size(); ++p)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::uint8_t> table = buildPatternTable(partition[p], log);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        log << "    built in " << seconds << " s\n";
+
+        // Pad to the recorded offset, then write the table
+        const std::uint64_t pos = static_cast<std::uint64_t>(out.tellp());
+        for (std::uint64_t i = pos; i < header.patterns[p].offset; ++i)
+            out.put('\0');
+        out.write(reinterpret_cast<const char *>(table.data()), static_cast<std::streamsize>(table.size()));
+    }
+
+    return static_cast<bool>(out);
+}
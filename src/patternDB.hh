@@ -0,0 +1,113 @@
+#pragma once
+
+#include "mappedFile.hh"
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Additive disjoint pattern database for the 4x4 puzzle.
+ *
+ * The tiles are split into disjoint groups (e.g. 6-6-3). For every placement
+ * of a group's tiles the table stores the minimum number of moves *of those
+ * tiles* needed to bring them home, with all other tiles treated as
+ * indistinguishable. Because only the group's own moves are counted, the
+ * values of all groups can be added and still never overestimate.
+ *
+ * On-disk format (little endian, version PDB_FORMAT_VERSION):
+ *  - PdbFileHeader
+ *  - one byte per entry for each pattern, at the offset given in its
+ *    PdbPatternInfo; entries are indexed by patternIndex().
+ *
+ * The file is memory-mapped by load(), so startup cost is independent of
+ * the table size and pages are only read when the solver touches them.
+ */
+
+constexpr std::uint32_t PDB_FORMAT_VERSION = 1;
+constexpr int PDB_MAX_PATTERNS = 4;
+constexpr int PDB_MAX_PATTERN_TILES = 8;
+
+struct PdbPatternInfo
+{
+    std::uint8_t tiles[PDB_MAX_PATTERN_TILES]; // tile values of the group
+    std::uint32_t tileCount;                   // number of used entries in tiles
+    std::uint32_t reserved;
+    std::uint64_t offset;  // byte offset of the table from the file start
+    std::uint64_t entries; // 16! / (16 - tileCount)!
+};
+
+struct PdbFileHeader
+{
+    char magic[8]; // "P15PDB\0\0"
+    std::uint32_t version;
+    std::uint32_t patternCount;
+    PdbPatternInfo patterns[PDB_MAX_PATTERNS];
+};
+
+class PatternDatabase
+{
+public:
+    PatternDatabase() { m_patternOf.fill(-1); }
+
+    // Map a database file; returns false if it is missing or malformed
+    bool load(const std::string &path);
+
+    bool isLoaded() const { return m_patternCount > 0; }
+    int patternCount() const { return m_patternCount; }
+
+    // Pattern the tile belongs to, or -1 for tiles not covered (and the blank)
+    int patternOf(int tile) const { return m_patternOf[tile]; }
+
+    // Table index of a pattern given the cell of every tile (tileCell[tile])
+    std::uint64_t patternIndex(int pattern, const std::array<int, 16> &tileCell) const;
+
+    // Stored cost for one pattern at a given table index
+    int lookup(int pattern, std::uint64_t index) const { return m_patterns[pattern].table[index]; }
+
+    // Sum of all pattern costs for a board (admissible estimate)
+    int estimate(const std::array<int, 16> &board) const;
+
+    std::size_t mappedBytes() const { return m_file.size(); }
+    std::size_t residentBytes() const { return m_file.residentBytes(); }
+
+    // Human readable partition, e.g. "6-6-3"
+    std::string describe() const;
+
+private:
+    struct Pattern
+    {
+        std::vector<int> tiles;
+        const std::uint8_t *table = nullptr;
+        std::uint64_t entries = 0;
+    };
+
+    MappedFile m_file;
+    Pattern m_patterns[PDB_MAX_PATTERNS];
+    int m_patternCount = 0;
+    std::array<int, 16> m_patternOf{};
+};
+
+// Classic 6-6-3 partition for the goal with the blank in the bottom-right corner
+std::vector<std::vector<int>> defaultPartition663();
+
+// 7-8 partition: stronger, but needs several GB of memory to generate
+std::vector<std::vector<int>> defaultPartition78();
+
+/**
+ * Build every pattern table by breadth-first search backwards from the goal
+ * and write the database file.
+ *
+ * Each table is generated with the blank position as part of the state:
+ * blank moves among foreign cells are free, moves of a pattern tile cost 1
+ * (0-1 BFS). The stored value is the minimum over blank positions.
+ *
+ * @param partition Disjoint tile groups (each 1..PDB_MAX_PATTERN_TILES tiles).
+ * @param path      Output file.
+ * @param log       Progress output.
+ * @return true if the file was written.
+ */
+bool generatePatternDatabase(const std::vector<std::vector<int>> &partition,
+                             const std::string &path, std::ostream &log);
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "board.hh"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Perfect ranking of permutations and partial permutations (up to 16 values).
+ *
+ * Ranks follow lexicographic order of the Lehmer code, read as a mixed-radix
+ * number: rank = ((d0 * (n - 1) + d1) * (n - 2) + d2) ...
+ *
+ *  - Ranking keeps, for every value, how many smaller values are already
+ *    placed, one nibble per value in a 64-bit word. Placing v adds 1 to
+ *    all nibbles above v with one shifted add, and the Lehmer digit of v
+ *    is v minus its nibble: no popcount instruction or inner loop needed.
+ *  - Unranking keeps the unused values as a sorted list of nibbles in one
+ *    64-bit word; taking the d-th smallest is a shift, and removing it is two
+ *    masks and a shift.
+ *
+ * Both directions are O(n) with no tables and no data-dependent branches,
+ * so they suit hot loops (pattern
+ * databases, dedup hashes, transposition keys, distance tables).
+ */
+
+constexpr int RANK_MAX_VALUES = 16;
+
+// Number of ordered placements of k values chosen from n: n! / (n - k)!
+constexpr std::uint64_t permutationCount(int n, int k)
+{
+    std::uint64_t count = 1;
+    for (int i = 0; i < k; ++i)
+        count *= static_cast<std::uint64_t>(n - i);
+    return count;
+}
+
+// Lehmer digits of values 0..15 placed one after another
+class LehmerCounter
+{
+public:
+    // Number of smaller values not placed yet; marks value as placed
+    int digit(int value)
+    {
+        const int shift = 4 * value;
+        const int digit = value - static_cast<int>((m_smallerPlaced >> shift) & 0xF);
+        m_smallerPlaced += (ONES << shift) << 4; // every larger value has one more smaller value placed
+        return digit;
+    }
+
+private:
+    static constexpr std::uint64_t ONES = 0x1111111111111111ull;
+    std::uint64_t m_smallerPlaced = 0;
+};
+
+// Values 0..15 not taken yet, smallest first, one nibble each
+class NibbleList
+{
+public:
+    // Remove and return the index-th smallest remaining value
+    int take(int index)
+    {
+        const int shift = 4 * index;
+        const int value = static_cast<int>((m_list >> shift) & 0xF);
+        const std::uint64_t below = (std::uint64_t(1) << shift) - 1; // shift <= 60
+        m_list = (m_list & below) | ((m_list >> 4) & ~below);
+        return value;
+    }
+
+private:
+    std::uint64_t m_list = 0xFEDCBA9876543210ull;
+};
+
+/**
+ * Rank of an ordered placement of k distinct values from 0..n-1.
+ *
+ * With k == n this is the lexicographic rank of a full permutation
+ * (0..n!-1); with k < n it indexes partial permutations, e.g. the cells
+ * of a pattern's tiles (0..n!/(n-k)!-1).
+ *
+ * @param values k distinct values below n (n <= 16).
+ * @param k      Number of values.
+ * @param n      Size of the value range.
+ * @return Dense rank.
+ */
+inline std::uint64_t rankPartial(const int *values, int k, int n)
+{
+    LehmerCounter lehmer;
+    std::uint64_t rank = 0;
+    for (int i = 0; i < k; ++i)
+        rank = rank * static_cast<std::uint64_t>(n - i) + static_cast<std::uint64_t>(lehmer.digit(values[i]));
+    return rank;
+}
+
+// Inverse of rankPartial: writes the k values of the placement with this rank
+inline void unrankPartial(std::uint64_t rank, int k, int n, int *values)
+{
+    int digits[RANK_MAX_VALUES];
+    for (int i = k - 1; i >= 0; --i)
+    {
+        const std::uint64_t radix = static_cast<std::uint64_t>(n - i);
+        digits[i] = static_cast<int>(rank % radix);
+        rank /= radix;
+    }
+
+    NibbleList unused;
+    for (int i = 0; i < k; ++i)
+        values[i] = unused.take(digits[i]);
+}
+
+inline std::uint64_t rankPermutation(const int *values, int n) { return rankPartial(values, n, n); }
+inline void unrankPermutation(std::uint64_t rank, int n, int *values) { unrankPartial(rank, n, n, values); }
+
+/**
+ * Dense 64-bit id of a board position (3x3: 0..9!-1, 4x4: 0..16!-1).
+ *
+ * Ranks the tiles array directly (blank = 0), so every arrangement,
+ * solvable or not, gets a distinct id; boardFromRank() restores it.
+ */
+template <int N>
+std::uint64_t rankBoard(const Board<N> &board)
+{
+    static_assert(N * N <= RANK_MAX_VALUES, "board too large for a 64-bit permutation rank");
+    return rankPermutation(board.tiles.data(), N * N);
+}
+
+template <int N>
+Board<N> boardFromRank(std::uint64_t rank)
+{
+    static_assert(N * N <= RANK_MAX_VALUES, "board too large for a 64-bit permutation rank");
+    Board<N> board;
+    unrankPermutation(rank, N * N, board.tiles.data());
+    for (int i = 0; i < N * N; ++i)
+        if (board.tiles[i] == 0)
+            board.emptyIdx = i;
+    return board;
+}
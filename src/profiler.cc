@@ -0,0 +1,222 @@
+#include "profiler.hh"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    constexpr std::size_t TRACE_BUFFER_EVENTS = 4096; // written out when 3/4 full, between frames
+
+    std::int64_t nanoseconds(FrameProfiler::Clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+
+    float milliseconds(FrameProfiler::Clock::duration duration)
+    {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+}
+
+const char *profileZoneName(ProfileZone zone)
+{
+    switch (zone)
+    {
+    case ProfileZone::Events:
+        return "events";
+    case ProfileZone::DrawUI:
+        return "drawUI";
+    case ProfileZone::DrawBoard:
+        return "drawBoard";
+    case ProfileZone::WinOverlay:
+        return "winOverlay";
+    case ProfileZone::Display:
+        return "display";
+    default:
+        return "?";
+    }
+}
+
+FrameProfiler::FrameProfiler() : m_origin(Clock::now()), m_launch(m_origin), m_frameStart(m_origin)
+{
+}
+
+FrameProfiler::~FrameProfiler()
+{
+    if (!m_trace.is_open())
+        return;
+    flushTrace();
+    m_trace << "\n]}\n";
+}
+
+bool FrameProfiler::openTrace(const std::string &path)
+{
+    m_trace.open(path, std::ios::trunc);
+    if (!m_trace)
+        return false;
+    m_tracePath = path;
+    m_traceBuffer.reserve(TRACE_BUFFER_EVENTS);
+    m_trace << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n"
+            << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"main loop\"}}";
+    return true;
+}
+
+void FrameProfiler::beginFrame()
+{
+    m_frameStart = Clock::now();
+    m_drawCalls = 0;
+}
+
+void FrameProfiler::addZone(ProfileZone zone, Clock::time_point start, Clock::time_point end)
+{
+    m_current.zoneMs[static_cast<int>(zone)] += milliseconds(end - start);
+    m_current.inputEvents += zone == ProfileZone::Events;
+    if (m_trace.is_open())
+        traceEvent(profileZoneName(zone), 'X', start, nanoseconds(end - start));
+}
+
+/**
+ * Close the frame started by beginFrame().
+ *
+ * Frame time is the drawing time plus the input handled since the previous
+ * frame; the time spent asleep waiting for events is not part of any frame.
+ */
+void FrameProfiler::endFrame()
+{
+    const Clock::time_point end = Clock::now();
+    m_current.frameMs = milliseconds(end - m_frameStart) + m_current.zoneMs[static_cast<int>(ProfileZone::Events)];
+    m_current.drawCalls = m_drawCalls;
+    const AllocationCounts allocated = threadAllocations();
+    m_current.allocations = {allocated.allocations - m_allocationMark.allocations, allocated.bytes - m_allocationMark.bytes};
+    m_allocationMark = allocated;
+    if (m_totalFrames == 0)
+        m_firstFrameMs = milliseconds(end - m_launch);
+    if (end - m_launch <= STARTUP_WINDOW)
+    {
+        if (m_current.frameMs > m_startupWorstMs)
+        {
+            m_startupWorstMs = m_current.frameMs;
+            m_startupWorstFrame = m_startupFrames;
+        }
+        ++m_startupFrames;
+    }
+    m_history[m_next] = m_current;
+    m_next = (m_next + 1) % HISTORY;
+    m_stored = std::min(m_stored + 1, HISTORY);
+    ++m_totalFrames;
+
+    if (m_trace.is_open())
+    {
+        traceEvent("frame", 'X', m_frameStart, nanoseconds(end - m_frameStart));
+        traceEvent("draw calls", 'C', m_frameStart, m_drawCalls);
+        if (m_traceBuffer.size() >= TRACE_BUFFER_EVENTS * 3 / 4)
+            flushTrace();
+    }
+    m_current = {};
+}
+
+void FrameProfiler::traceEvent(const char *name, char phase, Clock::time_point start, std::int64_t durationNs)
+{
+    // Bursts of input without a frame in between can fill the buffer
+    if (m_traceBuffer.size() == m_traceBuffer.capacity())
+        flushTrace();
+    m_traceBuffer.push_back({name, phase, nanoseconds(start - m_origin), durationNs});
+}
+
+void FrameProfiler::flushTrace()
+{
+    char line[160];
+    for (const TraceEvent &event : m_traceBuffer)
+    {
+        if (event.phase == 'C')
+            std::snprintf(line, sizeof(line),
+                          ",\n{\"name\": \"%s\", \"ph\": \"C\", \"ts\": %.3f, \"pid\": 1, \"tid\": 1, \"args\": {\"calls\": %lld}}",
+                          event.name, event.startNs / 1000.0, static_cast<long long>(event.durationNs));
+        else
+            std::snprintf(line, sizeof(line),
+                          ",\n{\"name\": \"%s\", \"cat\": \"frame\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": 1}",
+                          event.name, event.startNs / 1000.0, event.durationNs / 1000.0);
+        m_trace << line;
+    }
+    m_traceEvents += m_traceBuffer.size();
+    m_traceBuffer.clear();
+}
+
+FrameProfiler::Summary FrameProfiler::summary() const
+{
+    Summary result;
+    result.frames = m_stored;
+    if (m_stored == 0)
+        return result;
+
+    for (int i = 0; i < m_stored; ++i)
+    {
+        const FrameRecord &frame = m_history[i];
+        m_sorted[i] = frame.frameMs;
+        for (int zone = 0; zone < ZONES; ++zone)
+            result.zoneMs[zone] += frame.zoneMs[zone];
+
+        const bool allocated = frame.allocations.allocations > 0;
+        result.allocationFreeFrames += !allocated;
+        result.idleFrames += frame.inputEvents == 0;
+        result.idleAllocatingFrames += frame.inputEvents == 0 && allocated;
+    }
+    for (float &zone : result.zoneMs)
+        zone /= m_stored;
+
+    // Nearest-rank percentiles
+    std::sort(m_sorted.begin(), m_sorted.begin() + m_stored);
+    auto percentile = [&](int p)
+    { return m_sorted[std::max(0, (m_stored * p + 99) / 100 - 1)]; };
+    result.p50Ms = percentile(50);
+    result.p95Ms = percentile(95);
+    result.p99Ms = percentile(99);
+    result.maxMs = m_sorted[m_stored - 1];
+    const FrameRecord &last = m_history[(m_next + HISTORY - 1) % HISTORY];
+    result.drawCalls = last.drawCalls;
+    result.lastAllocations = last.allocations;
+    return result;
+}
+
+void FrameProfiler::formatOverlay(std::pmr::string &out) const
+{
+    const Summary stats = summary();
+    char line[96];
+    out.clear();
+    std::snprintf(line, sizeof(line), "frame ms  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f\n",
+                  stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+    out += line;
+    std::snprintf(line, sizeof(line), "%d frames, %d draw calls\n", stats.frames, stats.drawCalls);
+    out += line;
+    for (int zone = 0; zone < ZONES; ++zone)
+    {
+        std::snprintf(line, sizeof(line), "%-11s %6.3f ms\n", profileZoneName(static_cast<ProfileZone>(zone)), stats.zoneMs[zone]);
+        out += line;
+    }
+    if (ALLOCATION_TRACKING)
+    {
+        std::snprintf(line, sizeof(line), "heap: %llu allocs (%llu B) last frame\n%d of %d frames allocation-free\n",
+                      static_cast<unsigned long long>(stats.lastAllocations.allocations),
+                      static_cast<unsigned long long>(stats.lastAllocations.bytes), stats.allocationFreeFrames, stats.frames);
+        out += line;
+    }
+}
+
+void FrameProfiler::report(std::ostream &out) const
+{
+    const Summary stats = summary();
+    if (m_totalFrames > 0)
+        out << "Startup: first frame " << m_firstFrameMs << " ms after launch; worst of the " << m_startupFrames
+            << " frames in the first " << STARTUP_WINDOW.count() << " s: " << m_startupWorstMs << " ms (frame "
+            << m_startupWorstFrame + 1 << ")\n";
+    out << "Frame times (last " << stats.frames << " of " << m_totalFrames << " frames): p50 " << stats.p50Ms
+        << " ms, p95 " << stats.p95Ms << " ms, p99 " << stats.p99Ms << " ms, max " << stats.maxMs << " ms; mean per frame:";
+    for (int zone = 0; zone < ZONES; ++zone)
+        out << ' ' << profileZoneName(static_cast<ProfileZone>(zone)) << ' ' << stats.zoneMs[zone] << " ms"
+            << (zone + 1 < ZONES ? "," : "\n");
+    if (ALLOCATION_TRACKING)
+        out << "Heap: " << stats.allocationFreeFrames << " of " << stats.frames << " frames allocation-free; "
+            << stats.idleAllocatingFrames << " of " << stats.idleFrames << " frames without input allocated\n";
+    if (m_trace.is_open())
+        out << "Trace: " << m_traceEvents + m_traceBuffer.size() << " events written to " << m_tracePath << "\n";
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "allocTracker.hh"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Sections of a frame timed by the profiler (in overlay order)
+enum class ProfileZone : std::uint8_t
+{
+    Events,     // input handling since the previous frame
+    DrawUI,     // title and info panel
+    DrawBoard,  // tile patching and the grid draw calls
+    WinOverlay, // "YOU WIN!" backdrop and text
+    Display,    // window.display() (buffer swap, may wait for vsync)
+    Count
+};
+
+const char *profileZoneName(ProfileZone zone);
+
+/**
+ * Frame-time profiler for the main loop.
+ *
+ * ScopedZone times a section with two steady_clock reads and adds it to the
+ * frame in progress; endFrame() stores the frame in a fixed ring of the last
+ * HISTORY frames, from which the overlay reads frame-time percentiles, draw
+ * calls and mean section times. Nothing allocates after construction.
+ * In allocation-tracking builds (PUZZLE15_TRACK_ALLOCS) each frame also
+ * records the heap allocations the main thread made since the previous
+ * frame, and every zone is an AllocationSite.
+ *
+ * With a trace open, every zone and frame is also recorded as a Chrome
+ * trace_event (complete events, plus a draw-call counter) in a fixed buffer
+ * that is written out between frames; without one the only extra cost per
+ * zone is a branch.
+ */
+class FrameProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int HISTORY = 600; // ten seconds at 60 fps
+    static constexpr int ZONES = static_cast<int>(ProfileZone::Count);
+    static constexpr std::chrono::seconds STARTUP_WINDOW{5}; // frames after launch covered by the startup report
+
+    FrameProfiler();
+    ~FrameProfiler(); // finishes the trace file
+
+    FrameProfiler(const FrameProfiler &) = delete;
+    FrameProfiler &operator=(const FrameProfiler &) = delete;
+
+    /**
+     * Record the rest of the session as a Chrome trace (chrome://tracing, Perfetto).
+     *
+     * @param path Output JSON file (overwritten).
+     * @return false if the file cannot be created.
+     */
+    bool openTrace(const std::string &path);
+    bool tracing() const { return m_trace.is_open(); }
+
+    // Process start for the startup report (time to first frame); defaults to construction
+    void setLaunchTime(Clock::time_point launch) { m_launch = launch; }
+
+    // Frame drawing starts; events timed before it still count toward this frame
+    void beginFrame();
+    void addDrawCalls(int calls) { m_drawCalls += calls; }
+    // Frame presented: store it in the history (and the trace)
+    void endFrame();
+
+    void addZone(ProfileZone zone, Clock::time_point start, Clock::time_point end);
+
+    struct Summary
+    {
+        int frames = 0; // frames in the history window
+        float p50Ms = 0.f, p95Ms = 0.f, p99Ms = 0.f, maxMs = 0.f;
+        int drawCalls = 0; // of the last frame
+        std::array<float, ZONES> zoneMs{}; // mean per frame
+
+        // Allocation tracking builds only
+        AllocationCounts lastAllocations; // made for the last frame
+        int allocationFreeFrames = 0;     // frames without any heap allocation
+        int idleFrames = 0;               // frames with no input (timer ticks, hint polls, overlays)
+        int idleAllocatingFrames = 0;     // idle frames that still allocated
+    };
+
+    // Statistics over the last HISTORY frames
+    Summary summary() const;
+
+    // Overlay text (one line per statistic), e.g. into a FrameArena string
+    void formatOverlay(std::pmr::string &out) const;
+
+    // Print the startup figures and the summary (e.g. when the window closes)
+    void report(std::ostream &out) const;
+
+private:
+    struct FrameRecord
+    {
+        float frameMs = 0.f;
+        std::array<float, ZONES> zoneMs{};
+        int drawCalls = 0;
+        int inputEvents = 0;
+        AllocationCounts allocations;
+    };
+
+    struct TraceEvent
+    {
+        const char *name;
+        char phase;              // 'X' complete event, 'C' counter
+        std::int64_t startNs;    // since the profiler was created
+        std::int64_t durationNs; // for 'C': the counter value
+    };
+
+    void traceEvent(const char *name, char phase, Clock::time_point start, std::int64_t durationNs);
+    void flushTrace();
+
+    Clock::time_point m_origin;
+    Clock::time_point m_launch;
+    Clock::time_point m_frameStart;
+    FrameRecord m_current;
+
+    std::array<FrameRecord, HISTORY> m_history;
+    int m_next = 0;   // ring position of the next frame
+    int m_stored = 0; // frames in the ring (<= HISTORY)
+    int m_drawCalls = 0;
+    std::uint64_t m_totalFrames = 0;
+    AllocationCounts m_allocationMark; // main-thread totals at the end of the previous frame
+    mutable std::array<float, HISTORY> m_sorted; // scratch for percentiles
+
+    // Frames that ended within STARTUP_WINDOW of the launch
+    float m_firstFrameMs = 0.f; // launch to the end of the first frame
+    int m_startupFrames = 0;
+    float m_startupWorstMs = 0.f;
+    int m_startupWorstFrame = 0;
+
+    std::ofstream m_trace;
+    std::vector<TraceEvent> m_traceBuffer; // capacity fixed when the trace opens
+    std::uint64_t m_traceEvents = 0;
+    std::string m_tracePath;
+};
+
+// Times the enclosing scope as one zone of the current frame
+class ScopedZone
+{
+public:
+    ScopedZone(FrameProfiler &profiler, ProfileZone zone)
+        : m_profiler(profiler), m_zone(zone), m_site(profileZoneName(zone)), m_start(FrameProfiler::Clock::now()) {}
+    ~ScopedZone() { m_profiler.addZone(m_zone, m_start, FrameProfiler::Clock::now()); }
+
+    ScopedZone(const ScopedZone &) = delete;
+    ScopedZone &operator=(const ScopedZone &) = delete;
+
+private:
+    FrameProfiler &m_profiler;
+    ProfileZone m_zone;
+    AllocationSite m_site;
+    FrameProfiler::Clock::time_point m_start;
+};
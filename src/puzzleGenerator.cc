@@ -0,0 +1,91 @@
+#include "puzzleGenerator.hh"
+#include "packedBoard.hh"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    // Walks much longer than this are already close to uniform positions
+    constexpr int MAX_WALK_SLACK = 200;
+
+    // Random walk from the goal that never undoes its previous move
+    Board<4> randomWalk(int length, RandomEngine &rng)
+    {
+        Board<4> board;
+        int previous = -1;
+        for (int i = 0; i < length; ++i)
+        {
+            const int empty = board.emptyIdx;
+            int next;
+            do
+            {
+                std::uniform_int_distribution<> dis(0, PACKED_MOVES.count[empty] - 1);
+                next = PACKED_MOVES.target[empty][dis(rng)];
+            } while (next == previous);
+
+            std::swap(board.tiles[empty], board.tiles[next]);
+            previous = empty;
+            board.emptyIdx = next;
+        }
+        return board;
+    }
+}
+
+PuzzleGenerator::PuzzleGenerator(std::uint64_t seed, const SolverOptions &options)
+    : m_rng(seed), m_options(options)
+{
+}
+
+Board<4> PuzzleGenerator::uniform()
+{
+    Board<4> board;
+    shuffleBoard(board, m_rng);
+    ++m_stats.generated;
+    return board;
+}
+
+/**
+ * Random position whose optimal solution is exactly distance moves.
+ *
+ * Every move flips the permutation parity, so a walk of L moves always ends
+ * at an optimal distance of the same parity as L; the walk length therefore
+ * stays target + even slack. Too-short candidates grow the slack, candidates
+ * far above the target shrink it again.
+ *
+ * @param distance    Target optimal length (clamped to 0..MAX_DISTANCE).
+ * @param maxAttempts Candidates to solve before giving up.
+ * @return Position at that distance, or nullopt if every candidate fell short.
+ */
+std::optional<Board<4>> PuzzleGenerator::atDistance(int distance, int maxAttempts)
+{
+    distance = std::clamp(distance, 0, MAX_DISTANCE);
+    for (int attempt = 0; attempt < maxAttempts; ++attempt)
+    {
+        Board<4> board = randomWalk(distance + m_walkSlack, m_rng);
+        const SolverResult result = solvePuzzle(board.tiles, board.emptyIdx, m_options);
+        ++m_stats.attempts;
+        m_stats.nodesExpanded += result.stats.nodesExpanded;
+
+        const int found = static_cast<int>(result.moves.size());
+        if (found < distance)
+        {
+            m_walkSlack = std::min(m_walkSlack + 2, MAX_WALK_SLACK);
+            continue;
+        }
+        if (found > distance + 4 && m_walkSlack >= 2)
+            m_walkSlack -= 2;
+
+        // Walk the shortest path until exactly distance moves remain
+        for (int i = 0; i < found - distance; ++i)
+        {
+            const int next = result.moves[i];
+            std::swap(board.tiles[board.emptyIdx], board.tiles[next]);
+            board.emptyIdx = next;
+        }
+        ++m_stats.generated;
+        return board;
+    }
+    ++m_stats.failed;
+    return std::nullopt;
+}
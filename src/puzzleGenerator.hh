@@ -0,0 +1,65 @@
+#pragma once
+
+#include "board.hh"
+#include "solver.hh"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+// Work done by a generator since construction
+struct GeneratorStats
+{
+    std::uint64_t generated = 0;     // positions returned
+    std::uint64_t attempts = 0;      // candidates solved (exact-distance mode)
+    std::uint64_t failed = 0;        // exact-distance requests that ran out of attempts
+    std::uint64_t nodesExpanded = 0; // solver nodes over all attempts
+};
+
+/**
+ * Source of random 4x4 positions for difficulty tiers and bulk generation.
+ *
+ * Holds its own seeded RandomEngine, so one generator per thread produces a
+ * reproducible stream without locking or allocating per position.
+ */
+class PuzzleGenerator
+{
+public:
+    static constexpr int MAX_DISTANCE = 80; // farthest 4x4 positions
+
+    // Random positions this far out are rare (a few percent of candidates); beyond it
+    // requests increasingly exhaust the attempt budget
+    static constexpr int PRACTICAL_MAX_DISTANCE = 60;
+    static constexpr int DEFAULT_MAX_ATTEMPTS = 256;
+
+    explicit PuzzleGenerator(std::uint64_t seed, const SolverOptions &options = {});
+
+    // Uniformly random solvable position (see shuffleBoard)
+    Board<4> uniform();
+
+    /**
+     * Random position whose optimal solution is exactly distance moves.
+     *
+     * A candidate is drawn by a random walk from the goal and solved
+     * optimally; when its distance D is at least the target, the first
+     * D - distance moves of that optimal path lead to a position that is
+     * exactly distance moves from the goal (it lies on a shortest path).
+     * The walk length adapts so candidates land just above the target,
+     * which keeps the searches short. Long walks are nearly uniform, so
+     * targets above PRACTICAL_MAX_DISTANCE may need more candidates than
+     * the budget allows.
+     *
+     * @param distance    Target optimal length (0..MAX_DISTANCE).
+     * @param maxAttempts Candidates to solve before giving up.
+     * @return Position at that distance, or nullopt if no candidate reached it.
+     */
+    std::optional<Board<4>> atDistance(int distance, int maxAttempts = DEFAULT_MAX_ATTEMPTS);
+
+    const GeneratorStats &stats() const { return m_stats; }
+
+private:
+    RandomEngine m_rng;
+    SolverOptions m_options;
+    int m_walkSlack = 0; // extra walk length beyond the target (kept even)
+    GeneratorStats m_stats;
+};
@@ -0,0 +1,161 @@
+#include "replay.hh"
+#include "gameState.hh"
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    constexpr char REPLAY_MAGIC[8] = {'P', '1', '5', 'R', 'P', 'L', '\0', '\0'};
+}
+
+ReplayWriter::ReplayWriter(std::uint64_t seed, std::uint64_t startTime)
+    : m_seed(seed), m_startTime(startTime), m_lastTime(startTime)
+{
+    m_records.reserve(4096);
+}
+
+void ReplayWriter::append(std::uint64_t time, std::uint8_t action)
+{
+    // Times never go backwards on a steady clock; clamp just in case
+    std::uint64_t delta = time > m_lastTime ? time - m_lastTime : 0;
+    m_lastTime += delta;
+
+    do
+    {
+        std::uint8_t byte = delta & 0x7F;
+        delta >>= 7;
+        m_records.push_back(delta ? byte | 0x80 : byte);
+    } while (delta);
+    m_records.push_back(action);
+}
+
+void ReplayWriter::restart(std::uint64_t time, int size)
+{
+    append(time, static_cast<std::uint8_t>(REPLAY_RESTART | (size & 0x0F)));
+}
+
+void ReplayWriter::move(std::uint64_t time, int targetX, int targetY)
+{
+    // Off-board clicks cannot change the game, so they are not worth a record
+    if (targetX < 0 || targetX >= 8 || targetY < 0 || targetY >= 8)
+        return;
+    append(time, static_cast<std::uint8_t>(targetX + 8 * targetY));
+}
+
+void ReplayWriter::end(std::uint64_t time)
+{
+    append(time, REPLAY_END);
+}
+
+std::vector<unsigned char> ReplayWriter::serialize() const
+{
+    ReplayHeader header{};
+    std::memcpy(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    header.version = REPLAY_VERSION;
+    header.seed = m_seed;
+    header.startTime = m_startTime;
+    header.recordBytes = m_records.size();
+
+    std::vector<unsigned char> out(sizeof(header) + m_records.size());
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), m_records.data(), m_records.size());
+    return out;
+}
+
+bool ReplayWriter::appendTo(const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    const std::vector<unsigned char> bytes = serialize();
+    out.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    return static_cast<bool>(out);
+}
+
+bool ReplayReader::open(std::span<const unsigned char> data)
+{
+    m_corrupt = false;
+    if (data.size() < sizeof(ReplayHeader))
+        return false;
+
+    std::memcpy(&m_header, data.data(), sizeof(m_header));
+    if (std::memcmp(m_header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 || m_header.version != REPLAY_VERSION ||
+        m_header.recordBytes > data.size() - sizeof(ReplayHeader))
+        return false;
+
+    m_cursor = data.data() + sizeof(ReplayHeader);
+    m_end = m_cursor + m_header.recordBytes;
+    m_time = m_header.startTime;
+    return true;
+}
+
+std::size_t ReplayReader::sessionBytes() const
+{
+    return sizeof(ReplayHeader) + static_cast<std::size_t>(m_header.recordBytes);
+}
+
+bool ReplayReader::next(ReplayRecord &record)
+{
+    if (m_cursor == m_end)
+        return false;
+
+    std::uint64_t delta = 0;
+    for (int shift = 0;; shift += 7)
+    {
+        if (m_cursor == m_end || shift > 63)
+        {
+            m_corrupt = true;
+            return false;
+        }
+        const std::uint8_t byte = *m_cursor++;
+        delta |= std::uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            break;
+    }
+    if (m_cursor == m_end)
+    {
+        m_corrupt = true; // time without an action
+        return false;
+    }
+
+    m_time += delta;
+    record.time = m_time;
+    record.action = *m_cursor++;
+    return true;
+}
+
+/**
+ * Feed every record of a session back into a fresh GameState.
+ *
+ * @param session Bytes of one session.
+ * @return Final state; valid is false for malformed input.
+ */
+ReplayResult replaySession(std::span<const unsigned char> session)
+{
+    ReplayResult result;
+    ReplayReader reader;
+    if (!reader.open(session))
+        return result;
+
+    ManualGameClock clock;
+    clock.set(reader.header().startTime);
+    GameState game(clock, reader.header().seed);
+
+    ReplayRecord record;
+    while (reader.next(record))
+    {
+        clock.set(record.time);
+        if (record.isRestart())
+            game.restart(record.size());
+        else if (!record.isEnd())
+            game.tryMove(record.x(), record.y());
+        game.clearEvents();
+        ++result.records;
+    }
+
+    result.valid = !reader.corrupt();
+    result.size = game.board().size();
+    result.moveCount = game.moveCount();
+    result.won = game.won();
+    result.elapsedMilliseconds = game.elapsedMilliseconds();
+    return result;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+// Session layout: ReplayHeader, then recordBytes bytes of records.
+// Each record is a LEB128 varint time delta (ms since the previous record)
+// followed by one action byte: 0..63 = move at cell (x + 8 * y), 0x80 | size = restart,
+// 0x40 = end of session (only advances the clock). Sessions can be concatenated in one file.
+constexpr int REPLAY_VERSION = 2; // 2: uniform shuffle (a seed gives different boards than in 1)
+constexpr std::uint8_t REPLAY_RESTART = 0x80;
+constexpr std::uint8_t REPLAY_END = 0x40;
+
+struct ReplayHeader
+{
+    char magic[8]; // "P15RPL\0\0"
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t seed;        // GameState seed (determines every shuffle)
+    std::uint64_t startTime;   // game clock when recording started
+    std::uint64_t recordBytes; // size of the record stream that follows
+};
+
+struct ReplayRecord
+{
+    std::uint64_t time; // absolute game clock
+    std::uint8_t action;
+
+    bool isRestart() const { return action & REPLAY_RESTART; }
+    bool isEnd() const { return action == REPLAY_END; }
+    int size() const { return action & 0x0F; }
+    int x() const { return action % 8; }
+    int y() const { return action / 8 % 8; }
+};
+
+// Appends inputs to an in-memory log (typically 2-3 bytes per move)
+class ReplayWriter
+{
+public:
+    ReplayWriter(std::uint64_t seed, std::uint64_t startTime);
+
+    void restart(std::uint64_t time, int size);
+    void move(std::uint64_t time, int targetX, int targetY);
+
+    // Mark when the session stopped, so unfinished games replay with their full time
+    void end(std::uint64_t time);
+
+    // Header + records, ready to store or to append to a file of sessions
+    std::vector<unsigned char> serialize() const;
+
+    // Append this session to a file (created if missing)
+    bool appendTo(const std::string &path) const;
+
+    std::size_t recordBytes() const { return m_records.size(); }
+
+private:
+    void append(std::uint64_t time, std::uint8_t action);
+
+    std::uint64_t m_seed;
+    std::uint64_t m_startTime;
+    std::uint64_t m_lastTime;
+    std::vector<unsigned char> m_records;
+};
+
+// Sequential decoder of one session
+class ReplayReader
+{
+public:
+    // Parse the header at the start of data; false if it is not a replay
+    bool open(std::span<const unsigned char> data);
+
+    const ReplayHeader &header() const { return m_header; }
+
+    // Bytes taken by this session (header + records), to step to the next one
+    std::size_t sessionBytes() const;
+
+    // Next record; false at the end of the session or on corrupt data (see corrupt())
+    bool next(ReplayRecord &record);
+    bool corrupt() const { return m_corrupt; }
+
+private:
+    ReplayHeader m_header{};
+    const unsigned char *m_cursor = nullptr;
+    const unsigned char *m_end = nullptr;
+    std::uint64_t m_time = 0;
+    bool m_corrupt = false;
+};
+
+// Final state of a replayed session
+struct ReplayResult
+{
+    bool valid = false; // header and records decoded cleanly
+    int size = 0;
+    int moveCount = 0;
+    bool won = false;
+    std::uint64_t elapsedMilliseconds = 0;
+    std::uint64_t records = 0;
+};
+
+/**
+ * Re-run one recorded session through GameState with a manual clock.
+ *
+ * No window, audio or real time is involved, so this runs at full CPU
+ * speed and reproduces the recorded game exactly (same seed, same inputs,
+ * same timestamps).
+ *
+ * @param session Bytes starting with a ReplayHeader.
+ * @return Score and state at the end of the session.
+ */
+ReplayResult replaySession(std::span<const unsigned char> session);
@@ -0,0 +1,204 @@
+#include "simdHeuristics.hh"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PUZZLE15_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// Compile single functions for a newer instruction set than the rest of the build
+#if defined(__GNUC__) || defined(__clang__)
+#define PUZZLE15_TARGET(features) __attribute__((target(features)))
+#else
+#define PUZZLE15_TARGET(features) // MSVC emits any intrinsic without flags
+#endif
+
+namespace
+{
+    constexpr int CELLS = PACKED_CELLS;
+
+    // Tables indexed by cell or tile value, laid out for byte shuffles
+    struct alignas(16) ByteTable
+    {
+        std::uint8_t bytes[CELLS];
+    };
+
+    constexpr ByteTable makeTable(int (*value)(int))
+    {
+        ByteTable table{};
+        for (int i = 0; i < CELLS; ++i)
+            table.bytes[i] = static_cast<std::uint8_t>(value(i));
+        return table;
+    }
+
+    // The blank (0) maps to row/column 0; its distance is masked out afterwards
+    constexpr ByteTable GOAL_ROW = makeTable([](int tile)
+                                             { return tile ? (tile - 1) / 4 : 0; });
+    constexpr ByteTable GOAL_COLUMN = makeTable([](int tile)
+                                                { return tile ? (tile - 1) % 4 : 0; });
+    constexpr ByteTable CELL_ROW = makeTable([](int cell)
+                                             { return cell / 4; });
+    constexpr ByteTable CELL_COLUMN = makeTable([](int cell)
+                                                { return cell % 4; });
+    constexpr ByteTable GOAL_TILE = makeTable([](int cell)
+                                              { return cell < CELLS - 1 ? cell + 1 : 0; });
+
+    BoardEstimate evaluateScalar(PackedBoard board)
+    {
+        BoardEstimate estimate{0, 0, static_cast<std::uint8_t>(isSolvedPacked(board))};
+        for (int cell = 0; cell < CELLS; ++cell)
+        {
+            const int tile = packedTile(board, cell);
+            if (tile == 0)
+                continue;
+            const int rows = (tile - 1) / 4 - cell / 4;
+            const int columns = (tile - 1) % 4 - cell % 4;
+            estimate.manhattan += static_cast<std::uint8_t>((rows < 0 ? -rows : rows) + (columns < 0 ? -columns : columns));
+            estimate.misplaced += tile != cell + 1;
+        }
+        return estimate;
+    }
+
+#ifdef PUZZLE15_X86
+    // 16 cells of one board as bytes: cell 2k is the low nibble of byte k, cell 2k + 1 the high one
+    PUZZLE15_TARGET("sse4.1")
+    __m128i unpackCells(PackedBoard board)
+    {
+        const __m128i wide = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(&board)));
+        const __m128i low = _mm_and_si128(wide, _mm_set1_epi16(0x000F));
+        const __m128i high = _mm_and_si128(_mm_slli_epi16(wide, 4), _mm_set1_epi16(0x0F00));
+        return _mm_or_si128(low, high);
+    }
+
+    PUZZLE15_TARGET("sse4.1")
+    void evaluateSse41(std::span<const PackedBoard> boards, std::span<BoardEstimate> out)
+    {
+        const __m128i goalRow = _mm_load_si128(reinterpret_cast<const __m128i *>(GOAL_ROW.bytes));
+        const __m128i goalColumn = _mm_load_si128(reinterpret_cast<const __m128i *>(GOAL_COLUMN.bytes));
+        const __m128i cellRow = _mm_load_si128(reinterpret_cast<const __m128i *>(CELL_ROW.bytes));
+        const __m128i cellColumn = _mm_load_si128(reinterpret_cast<const __m128i *>(CELL_COLUMN.bytes));
+        const __m128i goalTile = _mm_load_si128(reinterpret_cast<const __m128i *>(GOAL_TILE.bytes));
+        const __m128i zero = _mm_setzero_si128();
+
+        for (std::size_t i = 0; i < boards.size(); ++i)
+        {
+            const __m128i tiles = unpackCells(boards[i]);
+            const __m128i rows = _mm_abs_epi8(_mm_sub_epi8(_mm_shuffle_epi8(goalRow, tiles), cellRow));
+            const __m128i columns = _mm_abs_epi8(_mm_sub_epi8(_mm_shuffle_epi8(goalColumn, tiles), cellColumn));
+            const __m128i blank = _mm_cmpeq_epi8(tiles, zero);
+            const __m128i distance = _mm_andnot_si128(blank, _mm_add_epi8(rows, columns));
+            const __m128i sums = _mm_sad_epu8(distance, zero);
+
+            const unsigned home = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(tiles, goalTile)));
+            const unsigned blankMask = static_cast<unsigned>(_mm_movemask_epi8(blank));
+            out[i].manhattan = static_cast<std::uint8_t>(_mm_extract_epi16(sums, 0) + _mm_extract_epi16(sums, 4));
+            out[i].misplaced = static_cast<std::uint8_t>(CELLS - std::popcount(home | blankMask));
+            out[i].solved = home == 0xFFFF;
+        }
+    }
+
+    PUZZLE15_TARGET("avx2")
+    void evaluateAvx2(std::span<const PackedBoard> boards, std::span<BoardEstimate> out)
+    {
+        const __m256i goalRow = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(GOAL_ROW.bytes)));
+        const __m256i goalColumn = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(GOAL_COLUMN.bytes)));
+        const __m256i cellRow = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(CELL_ROW.bytes)));
+        const __m256i cellColumn = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(CELL_COLUMN.bytes)));
+        const __m256i goalTile = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(GOAL_TILE.bytes)));
+        const __m256i lowNibble = _mm256_set1_epi16(0x000F);
+        const __m256i highNibble = _mm256_set1_epi16(0x0F00);
+        const __m256i zero = _mm256_setzero_si256();
+
+        // Two boards per register, one per 128-bit lane (byte shuffles stay within a lane)
+        std::size_t i = 0;
+        for (; i + 2 <= boards.size(); i += 2)
+        {
+            const __m256i wide = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&boards[i])));
+            const __m256i tiles = _mm256_or_si256(_mm256_and_si256(wide, lowNibble),
+                                                  _mm256_and_si256(_mm256_slli_epi16(wide, 4), highNibble));
+            const __m256i rows = _mm256_abs_epi8(_mm256_sub_epi8(_mm256_shuffle_epi8(goalRow, tiles), cellRow));
+            const __m256i columns = _mm256_abs_epi8(_mm256_sub_epi8(_mm256_shuffle_epi8(goalColumn, tiles), cellColumn));
+            const __m256i blank = _mm256_cmpeq_epi8(tiles, zero);
+            const __m256i distance = _mm256_andnot_si256(blank, _mm256_add_epi8(rows, columns));
+            const __m256i sums = _mm256_sad_epu8(distance, zero);
+
+            const unsigned home = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(tiles, goalTile)));
+            const unsigned present = home | static_cast<unsigned>(_mm256_movemask_epi8(blank));
+            for (int lane = 0; lane < 2; ++lane)
+            {
+                const unsigned laneHome = (home >> (16 * lane)) & 0xFFFF;
+                const __m128i laneSums = lane ? _mm256_extracti128_si256(sums, 1) : _mm256_castsi256_si128(sums);
+                out[i + lane].manhattan = static_cast<std::uint8_t>(_mm_extract_epi16(laneSums, 0) + _mm_extract_epi16(laneSums, 4));
+                out[i + lane].misplaced = static_cast<std::uint8_t>(CELLS - std::popcount((present >> (16 * lane)) & 0xFFFF));
+                out[i + lane].solved = laneHome == 0xFFFF;
+            }
+        }
+        if (i < boards.size())
+            out[i] = evaluateScalar(boards[i]);
+    }
+
+    SimdLevel probeCpu()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        const bool sse41 = (info[2] >> 19) & 1;
+        const bool osAvx = ((info[2] >> 27) & 1) && ((info[2] >> 28) & 1) && (_xgetbv(0) & 6) == 6;
+        bool avx2 = false;
+        if (osAvx && maxLeaf >= 7)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] >> 5) & 1;
+        }
+#else
+        __builtin_cpu_init();
+        const bool sse41 = __builtin_cpu_supports("sse4.1");
+        const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+        return avx2 ? SimdLevel::Avx2 : sse41 ? SimdLevel::Sse41 : SimdLevel::Scalar;
+    }
+#else
+    SimdLevel probeCpu() { return SimdLevel::Scalar; }
+#endif
+}
+
+SimdLevel detectSimdLevel()
+{
+    static const SimdLevel level = probeCpu();
+    return level;
+}
+
+const char *simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Avx2:
+        return "AVX2";
+    case SimdLevel::Sse41:
+        return "SSE4.1";
+    default:
+        return "scalar";
+    }
+}
+
+void evaluateBoards(std::span<const PackedBoard> boards, std::span<BoardEstimate> out, SimdLevel level)
+{
+    // Never run instructions the CPU lacks, whatever the caller asked for
+    level = std::max(level, detectSimdLevel());
+    out = out.first(boards.size());
+#ifdef PUZZLE15_X86
+    if (level == SimdLevel::Avx2)
+        return evaluateAvx2(boards, out);
+    if (level == SimdLevel::Sse41)
+        return evaluateSse41(boards, out);
+#endif
+    for (std::size_t i = 0; i < boards.size(); ++i)
+        out[i] = evaluateScalar(boards[i]);
+}
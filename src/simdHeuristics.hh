@@ -0,0 +1,45 @@
+#pragma once
+
+#include "packedBoard.hh"
+
+#include <cstdint>
+#include <span>
+
+// Instruction set used by evaluateBoards(), best first
+enum class SimdLevel
+{
+    Avx2,  // two boards per 256-bit register
+    Sse41, // one board per 128-bit register
+    Scalar // portable reference
+};
+
+// Per-board results of evaluateBoards()
+struct BoardEstimate
+{
+    std::uint8_t manhattan; // sum of tile distances to their goal cells
+    std::uint8_t misplaced; // tiles (not the blank) away from their goal cell
+    std::uint8_t solved;    // 1 for the goal position
+};
+
+// Best level this CPU supports (checked once, then cached)
+SimdLevel detectSimdLevel();
+
+const char *simdLevelName(SimdLevel level);
+
+/**
+ * Manhattan distance, misplaced-tile count and solved flag of many packed
+ * 4x4 boards at once.
+ *
+ * The vector paths widen each board's nibbles to bytes, look up every
+ * tile's goal row and column with a byte shuffle (pshufb), take the
+ * absolute differences to the cell coordinates and sum the 16 bytes with
+ * a SAD instruction, so a board costs a few instructions instead of a
+ * 16-step loop. Results are identical for every level; levels the CPU
+ * lacks fall back to the best one it has.
+ *
+ * @param boards Positions to evaluate (any count; tails use the scalar path).
+ * @param out    One estimate per board; must be at least as long as boards.
+ * @param level  Instruction set to use (defaults to detectSimdLevel()).
+ */
+void evaluateBoards(std::span<const PackedBoard> boards, std::span<BoardEstimate> out,
+                    SimdLevel level = detectSimdLevel());
@@ -0,0 +1,729 @@
+#include "solver.hh"
+#include "patternDB.hh"
+#include "packedBoard.hh"
+#include "threadPool.hh"
+#include "transpositionTable.hh"
+#include "walkingDistance.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <mutex>
+
+namespace
+{
+    constexpr int SIDE = 4;   // Board width/height
+    constexpr int CELLS = 16; // Number of cells
+    constexpr int FOUND = -1;     // Search result marker: goal reached
+    constexpr int CANCELLED = -2; // Search result marker: cancel flag was raised
+    constexpr std::uint64_t CANCEL_POLL_MASK = 4095; // poll the cancel flag every 4096 expansions
+    constexpr int INF = std::numeric_limits<int>::max();
+    constexpr std::size_t SPLIT_ITEMS_PER_THREAD = 16; // subtrees per worker, so stealing can even out the load
+    // Deepest frontier the root split collects. Paths of 6+ moves can meet (the shortest cycle
+    // is 12 moves), so deeper frontiers may hold the same position twice: still correct, the
+    // duplicate subtree is only searched twice (the transposition table absorbs some of it)
+    constexpr int MAX_SPLIT_DEPTH = 10;
+    constexpr int TT_MIN_SLACK = 2;                    // smallest bound - f whose subtree uses the transposition table
+
+    // Distance of tile (1–15) standing on a cell to its goal cell (tile - 1)
+    struct ManhattanTable
+    {
+        int dist[CELLS][CELLS]; // [tile][cell]
+    };
+
+    constexpr int absInt(int v) { return v < 0 ? -v : v; }
+
+    constexpr ManhattanTable makeManhattanTable()
+    {
+        ManhattanTable t{};
+        for (int tile = 1; tile < CELLS; ++tile)
+            for (int cell = 0; cell < CELLS; ++cell)
+                t.dist[tile][cell] = absInt((tile - 1) % SIDE - cell % SIDE) +
+                                     absInt((tile - 1) / SIDE - cell / SIDE);
+        return t;
+    }
+
+    constexpr ManhattanTable MANHATTAN = makeManhattanTable();
+
+    /*
+     * Linear conflict of one row or column.
+     *
+     * A line is encoded in base 5: each cell holds the goal offset (0–3) of a
+     * tile that belongs to this line, or 4 if the tile is foreign/empty.
+     * The penalty is 2 moves per tile that has to leave the line so the rest
+     * are in goal order: 2 * (tiles in line - longest increasing subsequence).
+     */
+    constexpr int LINE_CODES = 5 * 5 * 5 * 5;
+    constexpr int FOREIGN = 4;
+
+    struct ConflictTable
+    {
+        int penalty[LINE_CODES];
+    };
+
+    constexpr ConflictTable makeConflictTable()
+    {
+        ConflictTable t{};
+        for (int code = 0; code < LINE_CODES; ++code)
+        {
+            int goals[SIDE]{}, count = 0;
+            for (int c = 0, rest = code; c < SIDE; ++c, rest /= 5)
+                if (rest % 5 != FOREIGN)
+                    goals[count++] = rest % 5;
+
+            int lis[SIDE]{}, best = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                lis[i] = 1;
+                for (int j = 0; j < i; ++j)
+                    if (goals[j] < goals[i] && lis[j] + 1 > lis[i])
+                        lis[i] = lis[j] + 1;
+                best = lis[i] > best ? lis[i] : best;
+            }
+            t.penalty[code] = 2 * (count - best);
+        }
+        return t;
+    }
+
+    constexpr ConflictTable CONFLICTS = makeConflictTable();
+
+    int rowConflict(PackedBoard board, int row)
+    {
+        int code = 0;
+        for (int c = SIDE - 1; c >= 0; --c)
+        {
+            int tile = packedTile(board, row * SIDE + c);
+            bool mine = tile != 0 && (tile - 1) / SIDE == row;
+            code = code * 5 + (mine ? (tile - 1) % SIDE : FOREIGN);
+        }
+        return CONFLICTS.penalty[code];
+    }
+
+    int columnConflict(PackedBoard board, int col)
+    {
+        int code = 0;
+        for (int r = SIDE - 1; r >= 0; --r)
+        {
+            int tile = packedTile(board, r * SIDE + col);
+            bool mine = tile != 0 && (tile - 1) % SIDE == col;
+            code = code * 5 + (mine ? (tile - 1) / SIDE : FOREIGN);
+        }
+        return CONFLICTS.penalty[code];
+    }
+
+    /*
+     * Manhattan distance plus per-line conflicts.
+     * A move only recomputes the two lines the moved tile left and entered.
+     */
+    class ConflictHeuristic
+    {
+    public:
+        struct Saved
+        {
+            int manhattan, conflicts, lineA, lineB, penaltyA, penaltyB;
+            bool vertical;
+        };
+
+        explicit ConflictHeuristic(PackedBoard board)
+        {
+            manhattan = manhattanDistance(unpackBoard(board));
+            for (int i = 0; i < SIDE; ++i)
+            {
+                rowPenalty[i] = rowConflict(board, i);
+                colPenalty[i] = columnConflict(board, i);
+                conflicts += rowPenalty[i] + colPenalty[i];
+            }
+        }
+
+        int value() const { return manhattan + conflicts; }
+
+        // board is already updated: tile moved from cell `from` into cell `to`
+        Saved move(PackedBoard board, int tile, int from, int to)
+        {
+            const bool vertical = (from / SIDE) != (to / SIDE);
+            int *line = vertical ? rowPenalty : colPenalty;
+            const int a = vertical ? from / SIDE : from % SIDE;
+            const int b = vertical ? to / SIDE : to % SIDE;
+            Saved saved{manhattan, conflicts, a, b, line[a], line[b], vertical};
+
+            manhattan += MANHATTAN.dist[tile][to] - MANHATTAN.dist[tile][from];
+            line[a] = vertical ? rowConflict(board, a) : columnConflict(board, a);
+            line[b] = vertical ? rowConflict(board, b) : columnConflict(board, b);
+            conflicts += line[a] + line[b] - saved.penaltyA - saved.penaltyB;
+            return saved;
+        }
+
+        void undo(const Saved &saved)
+        {
+            int *line = saved.vertical ? rowPenalty : colPenalty;
+            line[saved.lineA] = saved.penaltyA;
+            line[saved.lineB] = saved.penaltyB;
+            manhattan = saved.manhattan;
+            conflicts = saved.conflicts;
+        }
+
+    private:
+        int manhattan = 0;
+        int conflicts = 0;
+        int rowPenalty[SIDE]{};
+        int colPenalty[SIDE]{};
+    };
+
+    /*
+     * Sum of the additive pattern database costs.
+     * A move only re-ranks the pattern that owns the moved tile.
+     */
+    class PatternHeuristic
+    {
+    public:
+        struct Saved
+        {
+            int tile, from, pattern, cost;
+        };
+
+        PatternHeuristic(PackedBoard board, const PatternDatabase &db)
+            : db(db)
+        {
+            for (int cell = 0; cell < CELLS; ++cell)
+                tileCell[packedTile(board, cell)] = cell;
+            for (int p = 0; p < db.patternCount(); ++p)
+            {
+                cost[p] = db.lookup(p, db.patternIndex(p, tileCell));
+                total += cost[p];
+            }
+        }
+
+        int value() const { return total; }
+
+        Saved move(PackedBoard, int tile, int from, int to)
+        {
+            tileCell[tile] = to;
+            const int p = db.patternOf(tile);
+            if (p < 0)
+                return {tile, from, -1, 0};
+
+            Saved saved{tile, from, p, cost[p]};
+            cost[p] = db.lookup(p, db.patternIndex(p, tileCell));
+            total += cost[p] - saved.cost;
+            return saved;
+        }
+
+        void undo(const Saved &saved)
+        {
+            tileCell[saved.tile] = saved.from;
+            if (saved.pattern < 0)
+                return;
+            total += saved.cost - cost[saved.pattern];
+            cost[saved.pattern] = saved.cost;
+        }
+
+    private:
+        const PatternDatabase &db;
+        std::array<int, CELLS> tileCell{};
+        int cost[PDB_MAX_PATTERNS]{};
+        int total = 0;
+    };
+
+    /*
+     * Walking distance of the rows plus that of the columns, or Manhattan
+     * distance plus linear conflict where that is larger (both are
+     * admissible, so their maximum is too). A vertical move steps the row
+     * state, a horizontal one the column state.
+     */
+    class WalkingDistanceHeuristic
+    {
+    public:
+        struct Saved
+        {
+            int rowState, columnState, total;
+            ConflictHeuristic::Saved conflict;
+        };
+
+        explicit WalkingDistanceHeuristic(PackedBoard board)
+            : wd(WalkingDistance::instance()), conflict(board)
+        {
+            const std::array<int, CELLS> cells = unpackBoard(board);
+            rowState = wd.rowState(cells);
+            columnState = wd.columnState(cells);
+            total = std::max(wd.distance(rowState) + wd.distance(columnState), conflict.value());
+        }
+
+        int value() const { return total; }
+
+        // board is already updated: tile moved from cell `from` into cell `to` (where the blank was)
+        Saved move(PackedBoard board, int tile, int from, int to)
+        {
+            Saved saved{rowState, columnState, total, conflict.move(board, tile, from, to)};
+            if (from / SIDE != to / SIDE)
+                rowState = wd.step(rowState, from > to, (tile - 1) / SIDE);
+            else
+                columnState = wd.step(columnState, from > to, (tile - 1) % SIDE);
+            total = std::max(wd.distance(rowState) + wd.distance(columnState), conflict.value());
+            return saved;
+        }
+
+        void undo(const Saved &saved)
+        {
+            conflict.undo(saved.conflict);
+            rowState = saved.rowState;
+            columnState = saved.columnState;
+            total = saved.total;
+        }
+
+    private:
+        const WalkingDistance &wd;
+        ConflictHeuristic conflict;
+        int rowState = 0;
+        int columnState = 0;
+        int total = 0;
+    };
+
+    // Depth-first threshold search over one board, generic in the heuristic
+    template <typename Heuristic>
+    class IdaSearch
+    {
+    public:
+        IdaSearch(PackedBoard start, int emptyIdx, Heuristic heuristic, const SolverOptions &options,
+                  const std::atomic<bool> *stop = nullptr)
+            : board(start), blank(emptyIdx), hash(zobristHash(start)), h(std::move(heuristic)),
+              cancel(options.cancel), stop(stop), transpositions(options.transpositions)
+        {
+            path.reserve(128);
+        }
+
+        int heuristic() const { return h.value(); }
+
+        // Returns FOUND, CANCELLED or the smallest f-value that exceeded bound
+        int search(int g, int bound, int prevBlank)
+        {
+            int estimate = h.value();
+            if (g + estimate > bound)
+                return g + estimate;
+            // Pattern databases need not cover every tile, so h == 0 alone is not enough
+            if (estimate == 0 && isSolvedPacked(board))
+                return FOUND;
+
+            // Only subtrees big enough to be worth a cache miss go through the table
+            const bool useTable = transpositions && bound - g - estimate >= TT_MIN_SLACK;
+            if (useTable)
+            {
+                ++stats.transpositionProbes;
+                const int stored = transpositions->probe(hash, board, prevBlank);
+                if (stored > 0)
+                    ++stats.transpositionHits;
+                if (stored > estimate)
+                {
+                    estimate = stored;
+                    if (g + estimate > bound)
+                    {
+                        ++stats.transpositionCutoffs;
+                        return g + estimate;
+                    }
+                }
+            }
+
+            ++stats.nodesExpanded;
+            if ((stats.nodesExpanded & CANCEL_POLL_MASK) == 0 && stopRequested())
+                return CANCELLED;
+
+            int next = INF;
+            const int from = blank;
+            for (int m = 0; m < PACKED_MOVES.count[from]; ++m)
+            {
+                const int target = PACKED_MOVES.target[from][m];
+                if (target == prevBlank)
+                    continue; // never undo the previous move
+
+                // Slide the tile into the empty cell
+                const int tile = packedTile(board, target);
+                board = slideTile(board, from, target);
+                hash = zobristMove(hash, tile, target, from);
+                blank = target;
+                const auto saved = h.move(board, tile, target, from);
+                path.push_back(target);
+
+                int t = search(g + 1, bound, from);
+                if (t == FOUND || t == CANCELLED)
+                    return t;
+                next = std::min(next, t);
+
+                // Undo the move
+                path.pop_back();
+                h.undo(saved);
+                blank = from;
+                hash = zobristMove(hash, tile, from, target);
+                board = slideTile(board, target, from);
+            }
+
+            // No solution within bound below this state: remember how far short it fell
+            if (useTable && next != INF)
+                transpositions->store(hash, board, prevBlank, next - g);
+            return next;
+        }
+
+        // The caller cancelled, or another thread of a parallel search already found the solution
+        bool stopRequested() const
+        {
+            return (cancel && cancel->load(std::memory_order_relaxed)) ||
+                   (stop && stop->load(std::memory_order_relaxed));
+        }
+
+        PackedBoard board;
+        int blank;
+        std::uint64_t hash; // Zobrist hash of board, updated with every slide
+        Heuristic h;
+        const std::atomic<bool> *cancel;
+        const std::atomic<bool> *stop;
+        TranspositionTable *transpositions;
+        std::vector<int> path;
+        SolverStats stats; // node and table counters of this search
+    };
+
+    template <typename Heuristic>
+    SolverResult runIdaStar(PackedBoard board, int emptyIdx, Heuristic heuristic, const SolverOptions &options)
+    {
+        SolverResult result;
+        const auto start = std::chrono::steady_clock::now();
+
+        IdaSearch<Heuristic> search(board, emptyIdx, std::move(heuristic), options);
+        int bound = search.heuristic();
+        const int initialBound = bound;
+        int iterations = 0;
+
+        while (true)
+        {
+            ++iterations;
+            int t = search.search(0, bound, -1);
+            if (t == FOUND)
+                break;
+            if (t == CANCELLED)
+            {
+                result.cancelled = true;
+                result.stats = search.stats;
+                return result;
+            }
+            bound = t;
+        }
+
+        result.solved = true;
+        result.moves = std::move(search.path);
+        result.stats = search.stats;
+        result.stats.initialBound = initialBound;
+        result.stats.iterations = iterations;
+        result.stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    void addCounters(SolverStats &into, const SolverStats &from)
+    {
+        into.nodesExpanded += from.nodesExpanded;
+        into.transpositionProbes += from.transpositionProbes;
+        into.transpositionHits += from.transpositionHits;
+        into.transpositionCutoffs += from.transpositionCutoffs;
+    }
+
+    // Root of one subtree handed to a worker: a node at the split depth and the moves leading to it
+    struct WorkItem
+    {
+        PackedBoard board;
+        int blank;
+        int prevBlank;
+        int g;
+        std::vector<int> prefix;
+    };
+
+    // Nodes above the split depth of one iteration
+    struct Frontier
+    {
+        std::vector<WorkItem> items;
+        std::vector<int> solution; // set if the goal lies above the split depth
+        bool solved = false;
+        int next = INF;            // smallest f that exceeded the bound above the split depth
+        std::uint64_t nodes = 0;
+    };
+
+    // Depth-limited DFS with the same pruning as IdaSearch; nodes at `depth` become work items
+    template <typename Heuristic>
+    void collectFrontier(PackedBoard board, int blank, int prevBlank, Heuristic &h, int g, int depth, int bound,
+                         std::vector<int> &prefix, Frontier &out)
+    {
+        const int estimate = h.value();
+        if (g + estimate > bound)
+        {
+            out.next = std::min(out.next, g + estimate);
+            return;
+        }
+        if (estimate == 0 && isSolvedPacked(board))
+        {
+            out.solved = true;
+            out.solution = prefix;
+            return;
+        }
+        if (g == depth)
+        {
+            out.items.push_back({board, blank, prevBlank, g, prefix});
+            return;
+        }
+
+        ++out.nodes;
+        const int from = blank;
+        for (int m = 0; m < PACKED_MOVES.count[from] && !out.solved; ++m)
+        {
+            const int target = PACKED_MOVES.target[from][m];
+            if (target == prevBlank)
+                continue;
+
+            const int tile = packedTile(board, target);
+            const PackedBoard child = slideTile(board, from, target);
+            const auto saved = h.move(child, tile, target, from);
+            prefix.push_back(target);
+            collectFrontier(child, target, from, h, g + 1, depth, bound, prefix, out);
+            prefix.pop_back();
+            h.undo(saved);
+        }
+    }
+
+    /*
+     * Root-split IDA*: every iteration expands the tree down to a shallow
+     * split depth on the calling thread, then searches the subtrees below it
+     * as independent pool tasks under the same bound. The first task that
+     * reaches the goal raises `stop`, which every other task polls like the
+     * cancel flag; the next bound is the minimum over all tasks.
+     */
+    template <typename MakeHeuristic>
+    SolverResult runParallelIdaStar(PackedBoard board, int emptyIdx, MakeHeuristic makeHeuristic,
+                                    WorkStealingPool &pool, const SolverOptions &options)
+    {
+        const std::atomic<bool> *cancel = options.cancel;
+        SolverResult result;
+        const auto start = std::chrono::steady_clock::now();
+
+        auto rootHeuristic = makeHeuristic(board);
+        int bound = rootHeuristic.value();
+        result.stats.initialBound = bound;
+
+        const std::size_t wantedItems = SPLIT_ITEMS_PER_THREAD * pool.size();
+        int depth = 1;
+        SolverStats counters; // node and table counters summed over the tasks (under taskMutex)
+
+        while (true)
+        {
+            ++result.stats.iterations;
+
+            // Deepen the split until there are enough subtrees to keep every worker busy
+            Frontier frontier;
+            std::vector<int> prefix;
+            while (true)
+            {
+                frontier = Frontier{};
+                collectFrontier(board, emptyIdx, -1, rootHeuristic, 0, depth, bound, prefix, frontier);
+                if (frontier.solved || frontier.items.size() >= wantedItems || depth == MAX_SPLIT_DEPTH ||
+                    depth >= bound)
+                    break;
+                ++depth;
+            }
+            counters.nodesExpanded += frontier.nodes;
+            if (frontier.solved)
+            {
+                result.moves = std::move(frontier.solution);
+                break;
+            }
+
+            std::atomic<bool> stop{false};
+            std::atomic<int> next{frontier.next};
+            std::mutex taskMutex;
+            for (const WorkItem &item : frontier.items)
+                pool.submit([&, bound]
+                            {
+                                if (stop.load(std::memory_order_relaxed) || (cancel && cancel->load(std::memory_order_relaxed)))
+                                    return;
+
+                                IdaSearch search(item.board, item.blank, makeHeuristic(item.board), options, &stop);
+                                const int t = search.search(item.g, bound, item.prevBlank);
+                                std::lock_guard lock(taskMutex);
+                                addCounters(counters, search.stats);
+                                if (t == FOUND)
+                                {
+                                    // Every solution under this bound is optimal; keep the first one reported
+                                    if (!stop.exchange(true))
+                                    {
+                                        result.moves = item.prefix;
+                                        result.moves.insert(result.moves.end(), search.path.begin(), search.path.end());
+                                    }
+                                }
+                                else if (t != CANCELLED)
+                                {
+                                    int seen = next.load(std::memory_order_relaxed);
+                                    while (t < seen && !next.compare_exchange_weak(seen, t))
+                                        ;
+                                } });
+            pool.wait();
+
+            if (stop)
+                break;
+            if (cancel && cancel->load(std::memory_order_relaxed))
+            {
+                result.cancelled = true;
+                addCounters(result.stats, counters);
+                return result;
+            }
+            bound = next;
+        }
+
+        result.solved = true;
+        addCounters(result.stats, counters);
+        result.stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+}
+
+double SolverStats::nodesPerSecond() const
+{
+    return seconds > 0.0 ? static_cast<double>(nodesExpanded) / seconds : 0.0;
+}
+
+double SolverStats::transpositionHitRate() const
+{
+    return transpositionProbes ? static_cast<double>(transpositionHits) / transpositionProbes : 0.0;
+}
+
+bool isSolvable(const std::array<int, 16> &board)
+{
+    int inversions = 0;
+    int emptyRowFromBottom = 0;
+    for (int i = 0; i < CELLS; ++i)
+    {
+        if (board[i] == 0)
+        {
+            emptyRowFromBottom = SIDE - i / SIDE;
+            continue;
+        }
+        for (int j = i + 1; j < CELLS; ++j)
+            if (board[j] != 0 && board[j] < board[i])
+                ++inversions;
+    }
+    return (inversions + emptyRowFromBottom) % 2 == 1;
+}
+
+bool parseBoard(const std::string &line, std::array<int, 16> &board)
+{
+    std::array<int, 16> parsed{};
+    unsigned seen = 0;
+    int count = 0;
+    for (std::size_t i = 0; i < line.size();)
+    {
+        if (line[i] == '#')
+            break; // trailing comment, e.g. the known optimal length
+        if (line[i] < '0' || line[i] > '9')
+        {
+            if (line[i] != ' ' && line[i] != ',' && line[i] != '\t' && line[i] != '\r')
+                return false;
+            ++i;
+            continue;
+        }
+
+        int value = 0;
+        for (; i < line.size() && line[i] >= '0' && line[i] <= '9'; ++i)
+            value = std::min(value * 10 + (line[i] - '0'), CELLS); // clamp: anything >= 16 is invalid
+        if (count == CELLS || value >= CELLS || (seen & (1u << value)))
+            return false;
+        seen |= 1u << value;
+        parsed[count++] = value;
+    }
+
+    if (count != CELLS)
+        return false;
+    board = parsed;
+    return true;
+}
+
+int manhattanDistance(const std::array<int, 16> &board)
+{
+    int sum = 0;
+    for (int cell = 0; cell < CELLS; ++cell)
+        if (board[cell] != 0)
+            sum += MANHATTAN.dist[board[cell]][cell];
+    return sum;
+}
+
+int linearConflict(const std::array<int, 16> &board)
+{
+    const PackedBoard packed = packBoard(board);
+    int sum = 0;
+    for (int i = 0; i < SIDE; ++i)
+        sum += rowConflict(packed, i) + columnConflict(packed, i);
+    return sum;
+}
+
+std::size_t heuristicTableBytes(const SolverOptions &options)
+{
+    if (options.heuristic == SolverHeuristic::PatternDatabase &&
+        options.patterns && options.patterns->isLoaded())
+        return options.patterns->mappedBytes();
+    if (options.heuristic == SolverHeuristic::WalkingDistance)
+        return WalkingDistance::instance().memoryBytes();
+    return sizeof(MANHATTAN) + sizeof(CONFLICTS);
+}
+
+/**
+ * Solve the board optimally with IDA*.
+ *
+ * Each iteration is a depth-first search bounded by f = g + h; the next
+ * bound is the smallest f that exceeded the current one, so the first
+ * solution found is a shortest one.
+ *
+ * @param board    Start position.
+ * @param emptyIdx Index of the empty tile.
+ * @param options  Heuristic selection.
+ * @return Move sequence and statistics.
+ */
+SolverResult solvePuzzle(const std::array<int, 16> &board, int emptyIdx,
+                         const SolverOptions &options)
+{
+    if (!isSolvable(board))
+        return {};
+
+    const PackedBoard packed = packBoard(board);
+    if (options.heuristic == SolverHeuristic::PatternDatabase &&
+        options.patterns && options.patterns->isLoaded())
+        return runIdaStar(packed, emptyIdx, PatternHeuristic(packed, *options.patterns), options);
+    if (options.heuristic == SolverHeuristic::WalkingDistance)
+        return runIdaStar(packed, emptyIdx, WalkingDistanceHeuristic(packed), options);
+
+    return runIdaStar(packed, emptyIdx, ConflictHeuristic(packed), options);
+}
+
+/**
+ * Solve the board optimally with root-split parallel IDA*.
+ *
+ * Same iterations and bounds as solvePuzzle(); only the subtrees below the
+ * split depth run on the pool. Node counts include the work other threads
+ * did after the solution was found, until they saw the stop flag.
+ *
+ * @param board    Start position.
+ * @param emptyIdx Index of the empty tile.
+ * @param pool     Workers that search the subtrees.
+ * @param options  Heuristic selection and cancel flag.
+ * @return Move sequence and statistics.
+ */
+SolverResult solvePuzzleParallel(const std::array<int, 16> &board, int emptyIdx, WorkStealingPool &pool,
+                                 const SolverOptions &options)
+{
+    if (!isSolvable(board))
+        return {};
+
+    const PackedBoard packed = packBoard(board);
+    if (options.heuristic == SolverHeuristic::PatternDatabase &&
+        options.patterns && options.patterns->isLoaded())
+    {
+        const PatternDatabase &db = *options.patterns;
+        return runParallelIdaStar(packed, emptyIdx, [&db](PackedBoard b)
+                                  { return PatternHeuristic(b, db); }, pool, options);
+    }
+    if (options.heuristic == SolverHeuristic::WalkingDistance)
+        return runParallelIdaStar(packed, emptyIdx, [](PackedBoard b)
+                                  { return WalkingDistanceHeuristic(b); }, pool, options);
+
+    return runParallelIdaStar(packed, emptyIdx, [](PackedBoard b)
+                              { return ConflictHeuristic(b); }, pool, options);
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class PatternDatabase;
+class TranspositionTable;
+class WorkStealingPool;
+
+// Admissible estimate used to guide the search
+enum class SolverHeuristic
+{
+    ManhattanLinearConflict, // no tables needed
+    PatternDatabase,         // additive pattern database (falls back if not loaded)
+    WalkingDistance          // walking distance, or Manhattan + conflicts where larger (660 KB built on first use)
+};
+
+// Search configuration; defaults to the table-free heuristic
+struct SolverOptions
+{
+    SolverHeuristic heuristic = SolverHeuristic::ManhattanLinearConflict;
+    const PatternDatabase *patterns = nullptr; // required by SolverHeuristic::PatternDatabase
+
+    // Polled during the search; once it reads true the search stops with cancelled == true
+    const std::atomic<bool> *cancel = nullptr;
+
+    // Lower bounds shared between iterations, threads and searches (none if null)
+    TranspositionTable *transpositions = nullptr;
+};
+
+/**
+ * Counters collected while searching for a solution.
+ *
+ * nodesExpanded counts every state whose successors were generated, summed
+ * over all IDA* iterations, so it can be compared between builds to catch
+ * heuristic or move-generation regressions independently of machine speed.
+ */
+struct SolverStats
+{
+    std::uint64_t nodesExpanded = 0; // states expanded over all iterations
+    int iterations = 0;              // number of IDA* threshold iterations
+    int initialBound = 0;            // heuristic value of the start state
+    double seconds = 0.0;            // wall-clock search time
+
+    std::uint64_t transpositionProbes = 0;  // table lookups (large enough subtrees only)
+    std::uint64_t transpositionHits = 0;    // lookups that found a stored bound
+    std::uint64_t transpositionCutoffs = 0; // states pruned because the stored bound exceeded the threshold
+
+    // Share of probes that found a bound (0 without a table)
+    double transpositionHitRate() const;
+
+    // Expansion rate of the search (0 when no time was measured)
+    double nodesPerSecond() const;
+};
+
+/**
+ * Result of an optimal search.
+ *
+ * moves holds the board indices the empty tile moves to, in order. Each entry
+ * is therefore the tile that has to be clicked next, i.e. it can be replayed
+ * with moveTile(board, idx % N, idx / N) or GameState::tryMove(idx % N, idx / N).
+ */
+struct SolverResult
+{
+    bool solved = false;    // false if the position is unsolvable or the search was cancelled
+    bool cancelled = false; // stopped early through SolverOptions::cancel
+    std::vector<int> moves; // optimal move sequence (empty tile destinations)
+    SolverStats stats;
+};
+
+/**
+ * Check whether a 4x4 position can reach the solved state.
+ *
+ * For an even board width the position is solvable when the number of
+ * inversions plus the row of the empty tile (counted from the bottom) is odd.
+ *
+ * @param board Puzzle board (values 1–15 are tiles, 0 is the empty space).
+ * @return true if the solved state is reachable.
+ */
+bool isSolvable(const std::array<int, 16> &board);
+
+/**
+ * Parse a position written as 16 numbers (0 = empty), separated by spaces,
+ * commas or tabs, in row-major order. Anything after a '#' is a comment.
+ *
+ * @param line  Text to parse.
+ * @param board Receives the position on success.
+ * @return true if the line holds a permutation of 0–15.
+ */
+bool parseBoard(const std::string &line, std::array<int, 16> &board);
+
+/**
+ * Sum of the Manhattan distances of all tiles to their goal cells.
+ *
+ * @param board Puzzle board.
+ * @return Admissible lower bound on the number of moves left.
+ */
+int manhattanDistance(const std::array<int, 16> &board);
+
+/**
+ * Extra moves forced by tiles that sit in their goal row (or column) but
+ * in reversed order. Adding it to the Manhattan distance stays admissible.
+ *
+ * @param board Puzzle board.
+ * @return Linear-conflict penalty (always even).
+ */
+int linearConflict(const std::array<int, 16> &board);
+
+/**
+ * Memory taken by the lookup tables of the heuristic that options select.
+ *
+ * Follows the same fallback as the solver: a pattern database that is not
+ * loaded counts as Manhattan distance plus linear conflict.
+ *
+ * @param options Heuristic selection.
+ * @return Bytes of tables (mapped file size for a pattern database).
+ */
+std::size_t heuristicTableBytes(const SolverOptions &options);
+
+/**
+ * Find a shortest move sequence that solves the board.
+ *
+ * Runs IDA* guided by the heuristic selected in options (Manhattan distance
+ * plus linear conflict by default). The heuristic is updated incrementally on
+ * every move, and immediate move reversals are pruned, so each node costs a
+ * handful of table lookups. With options.transpositions, states with room
+ * left under the threshold also look up and record proven lower bounds.
+ *
+ * @param board    Start position (not modified).
+ * @param emptyIdx Index of the empty tile in board.
+ * @param options  Heuristic selection; the pattern database is only read.
+ * @return Optimal solution and search statistics; solved == false if the
+ *         position is not solvable.
+ */
+SolverResult solvePuzzle(const std::array<int, 16> &board, int emptyIdx,
+                         const SolverOptions &options = {});
+
+/**
+ * Find a shortest move sequence for one position on several threads.
+ *
+ * Root-split IDA*: each iteration expands the first few levels of the tree
+ * on the calling thread and searches the subtrees below them as pool tasks
+ * (about 16 per worker, so work stealing can balance uneven subtrees). All
+ * tasks share the iteration bound and the next-bound minimum; the first one
+ * that reaches the goal stops the others. The result is optimal like
+ * solvePuzzle(), but when several optimal solutions exist, which one is
+ * returned depends on thread timing.
+ *
+ * Must not be called from a task of the same pool (wait() would deadlock).
+ *
+ * @param board    Start position (not modified).
+ * @param emptyIdx Index of the empty tile in board.
+ * @param pool     Workers that search the subtrees.
+ * @param options  Heuristic selection and cancel flag.
+ * @return Optimal solution and statistics summed over all threads.
+ */
+SolverResult solvePuzzleParallel(const std::array<int, 16> &board, int emptyIdx, WorkStealingPool &pool,
+                                 const SolverOptions &options = {});
@@ -0,0 +1,193 @@
+#include "soundService.hh"
+
+#include <algorithm>
+
+SoundService::SoundService(AssetManager &assets) : m_assets(assets)
+{
+    if (m_assets.hasSound(SoundId::Click))
+    {
+        m_clickVoices.reserve(CLICK_VOICES);
+        for (int i = 0; i < CLICK_VOICES; ++i)
+            m_clickVoices.emplace_back(m_assets.sound(SoundId::Click));
+    }
+    if (m_assets.hasSound(SoundId::Win))
+        m_winVoice.emplace(m_assets.sound(SoundId::Win));
+    m_worker = std::thread(&SoundService::run, this);
+}
+
+SoundService::~SoundService()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+
+    for (sf::Sound &voice : m_clickVoices)
+        voice.stop();
+    if (m_winVoice)
+        m_winVoice->stop();
+    if (m_assets.hasMusic())
+        m_assets.music().stop();
+}
+
+void SoundService::click()
+{
+    post(Command::Click);
+}
+
+void SoundService::win()
+{
+    post(Command::Win);
+}
+
+void SoundService::endWin()
+{
+    post(Command::EndWin);
+}
+
+void SoundService::setMusicEnabled(bool enabled)
+{
+    m_musicEnabled = enabled;
+    post(enabled ? Command::MusicOn : Command::MusicOff);
+}
+
+/**
+ * Queue a request for the worker; never blocks on audio.
+ *
+ * @param command What to play or change.
+ */
+void SoundService::post(Command command)
+{
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_pending == m_queue.size())
+        {
+            ++m_dropped;
+            return;
+        }
+        m_queue[(m_head + m_pending) % m_queue.size()] = {command, now};
+        ++m_pending;
+    }
+    m_wake.notify_one();
+}
+
+// Worker: drain the queue in order, doing the audio calls outside the lock
+void SoundService::run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this]
+                    { return m_stopping || m_pending > 0; });
+        if (m_stopping)
+            return;
+
+        const Request request = m_queue[m_head];
+        m_head = (m_head + 1) % m_queue.size();
+        --m_pending;
+        lock.unlock();
+
+        const bool played = execute(request.command);
+        const auto end = std::chrono::steady_clock::now();
+
+        lock.lock();
+        if (played)
+        {
+            ++m_played;
+            m_latencyMs[m_latencyNext] = std::chrono::duration<double, std::milli>(end - request.posted).count();
+            m_latencyNext = (m_latencyNext + 1) % LATENCY_HISTORY;
+            m_latencyStored = std::min(m_latencyStored + 1, LATENCY_HISTORY);
+        }
+    }
+}
+
+bool SoundService::execute(Command command)
+{
+    sf::Music &music = m_assets.music();
+    const bool hasMusic = m_assets.hasMusic();
+
+    switch (command)
+    {
+    case Command::Click:
+        if (m_clickVoices.empty())
+            return false;
+        clickVoice().play();
+        return true;
+
+    case Command::Win:
+        m_ducked = true;
+        if (hasMusic)
+            music.pause();
+        if (!m_winVoice)
+            return false;
+        m_winVoice->play();
+        return true;
+
+    case Command::EndWin:
+        if (m_winVoice)
+            m_winVoice->stop();
+        m_ducked = false;
+        if (m_musicOn && hasMusic && music.getStatus() != sf::SoundSource::Status::Playing)
+            music.play();
+        return false;
+
+    case Command::MusicOn:
+        m_musicOn = true;
+        if (!m_ducked && hasMusic)
+            music.play();
+        return false;
+
+    case Command::MusicOff:
+        m_musicOn = false;
+        if (hasMusic)
+            music.pause();
+        return false;
+    }
+    return false;
+}
+
+/**
+ * Pick the voice for the next click.
+ *
+ * Every voice remembers when it last started; an idle voice is used if
+ * there is one, otherwise the one started longest ago is cut off.
+ *
+ * @return An idle voice, or the oldest busy one (stopped).
+ */
+sf::Sound &SoundService::clickVoice()
+{
+    std::size_t oldest = 0;
+    bool idle = false;
+    for (std::size_t i = 0; i < m_clickVoices.size() && !idle; ++i)
+    {
+        idle = m_clickVoices[i].getStatus() != sf::SoundSource::Status::Playing;
+        if (idle || m_voiceStarted[i] < m_voiceStarted[oldest])
+            oldest = i;
+    }
+    if (!idle)
+    {
+        ++m_stolen;
+        m_clickVoices[oldest].stop();
+    }
+    m_voiceStarted[oldest] = ++m_clicks;
+    return m_clickVoices[oldest];
+}
+
+void SoundService::report(std::ostream &out) const
+{
+    std::lock_guard lock(m_mutex);
+    std::vector<double> sorted(m_latencyMs.begin(), m_latencyMs.begin() + m_latencyStored);
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p)
+    {
+        return sorted.empty() ? 0.0 : sorted[static_cast<std::size_t>(p * (sorted.size() - 1))];
+    };
+
+    out << "Sounds: " << m_played << " effects played on " << m_clickVoices.size() << " click voices ("
+        << m_stolen << " cut off, " << m_dropped << " requests dropped); trigger-to-play latency over the last "
+        << sorted.size() << " p50 "
+        << percentile(0.5) << " ms, p95 " << percentile(0.95) << " ms, max " << percentile(1.0) << " ms\n";
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "assetManager.hh"
+
+#include <SFML/Audio.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+/**
+ * Plays sound effects and drives the background music from a worker thread.
+ *
+ * The input path only posts a request into a fixed ring (no allocation, no
+ * audio call); the worker starts it on one of a fixed pool of voices built
+ * up front over the buffers decoded by the AssetManager, so clicks from fast
+ * key repeat overlap instead of cutting each other off. When every click
+ * voice is busy the one started longest ago is restarted.
+ *
+ * The music is ducked (paused) while the win sound plays and resumed by
+ * endWin(), unless the player turned it off with setMusicEnabled(false).
+ * Trigger-to-play latency (post to play() returning on the worker) is
+ * recorded for the most recent effects and printed by report().
+ */
+class SoundService
+{
+public:
+    static constexpr int CLICK_VOICES = 6; // overlapping clicks before the oldest is cut off
+    static constexpr int QUEUE_SIZE = 64;  // pending requests; further ones are dropped
+
+    // assets must have finished loading and outlive the service
+    explicit SoundService(AssetManager &assets);
+    ~SoundService();
+
+    SoundService(const SoundService &) = delete;
+    SoundService &operator=(const SoundService &) = delete;
+
+    // A tile moved
+    void click();
+
+    // The puzzle was solved: play the win sound and duck the music
+    void win();
+
+    // The win celebration is over (overlay expired or new game): stop the win sound, resume the music
+    void endWin();
+
+    // Music on/off as chosen by the player (starts it the first time)
+    void setMusicEnabled(bool enabled);
+    bool musicEnabled() const { return m_musicEnabled; }
+
+    // Print effects played, voices stolen, requests dropped and recent trigger-to-play latency
+    void report(std::ostream &out) const;
+
+private:
+    enum class Command : std::uint8_t
+    {
+        Click,
+        Win,
+        EndWin,
+        MusicOn,
+        MusicOff
+    };
+
+    struct Request
+    {
+        Command command;
+        std::chrono::steady_clock::time_point posted;
+    };
+
+    void post(Command command);
+    void run();
+    bool execute(Command command); // worker only; true if an effect started
+    sf::Sound &clickVoice();       // worker only
+
+    AssetManager &m_assets;
+    bool m_musicEnabled = false; // main thread's view, for the info panel
+
+    // Audio objects, touched only by the worker (and the destructor once it stopped)
+    std::vector<sf::Sound> m_clickVoices;
+    std::optional<sf::Sound> m_winVoice;
+    std::array<std::uint64_t, CLICK_VOICES> m_voiceStarted{}; // click number each voice last started
+    std::uint64_t m_clicks = 0;
+    bool m_musicOn = false;
+    bool m_ducked = false;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::array<Request, QUEUE_SIZE> m_queue{};
+    std::size_t m_head = 0;
+    std::size_t m_pending = 0;
+    bool m_stopping = false;
+
+    std::uint64_t m_played = 0;
+    std::atomic<std::uint64_t> m_stolen{0}; // counted by the worker outside the lock
+    std::uint64_t m_dropped = 0;
+
+    // post() to play(), for the last LATENCY_HISTORY effects
+    static constexpr std::size_t LATENCY_HISTORY = 1024;
+    std::array<double, LATENCY_HISTORY> m_latencyMs{};
+    std::size_t m_latencyNext = 0;   // ring position of the next sample
+    std::size_t m_latencyStored = 0; // samples in the ring (<= LATENCY_HISTORY)
+
+    std::thread m_worker; // started last, once every member is initialized
+};
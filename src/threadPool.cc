@@ -0,0 +1,125 @@
+#include "threadPool.hh"
+
+#include <algorithm>
+
+namespace
+{
+    // Pool and worker index of the current thread (nullptr outside any pool)
+    thread_local const WorkStealingPool *currentPool = nullptr;
+    thread_local unsigned currentWorker = 0;
+}
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < threadCount; ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+    for (unsigned i = 0; i < threadCount; ++i)
+        m_threads.emplace_back(&WorkStealingPool::run, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    wait();
+    {
+        std::lock_guard lock(m_stateMutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (auto &thread : m_threads)
+        thread.join();
+}
+
+/**
+ * Queue a task for execution.
+ *
+ * From inside a worker the task goes to that worker's own queue, otherwise
+ * queues are picked round-robin.
+ *
+ * @param task Callable to run on a pool thread.
+ */
+void WorkStealingPool::submit(std::function<void()> task)
+{
+    const unsigned target = currentPool == this
+                                ? currentWorker
+                                : m_nextWorker.fetch_add(1, std::memory_order_relaxed) % size();
+
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard lock(m_workers[target]->mutex);
+        m_workers[target]->tasks.push_back(std::move(task));
+    }
+    {
+        // Publish under the state mutex so a worker about to sleep cannot miss it
+        std::lock_guard lock(m_stateMutex);
+        m_queued.fetch_add(1, std::memory_order_release);
+    }
+    m_workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock lock(m_stateMutex);
+    m_allDone.wait(lock, [this]
+                   { return m_pending.load(std::memory_order_acquire) == 0; });
+}
+
+bool WorkStealingPool::popLocal(unsigned index, std::function<void()> &task)
+{
+    Worker &worker = *m_workers[index];
+    std::lock_guard lock(worker.mutex);
+    if (worker.tasks.empty())
+        return false;
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned index, std::function<void()> &task)
+{
+    const unsigned count = size();
+    for (unsigned offset = 1; offset < count; ++offset)
+    {
+        Worker &victim = *m_workers[(index + offset) % count];
+        std::lock_guard lock(victim.mutex);
+        if (victim.tasks.empty())
+            continue;
+        task = std::move(victim.tasks.front()); // oldest task = usually the biggest
+        victim.tasks.pop_front();
+        m_steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::run(unsigned index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    std::function<void()> task;
+    while (true)
+    {
+        if (popLocal(index, task) || steal(index, task))
+        {
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            task = nullptr;
+
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard lock(m_stateMutex);
+                m_allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(m_stateMutex);
+        m_workAvailable.wait(lock, [this]
+                             { return m_stopping || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_stopping && m_queued.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
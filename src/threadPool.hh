@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size thread pool with per-worker task queues and work stealing.
+ *
+ * Tasks submitted from a worker go to the back of that worker's own queue
+ * and are popped LIFO (good cache locality for recursive splitting); tasks
+ * submitted from outside are spread round-robin. Idle workers steal from the
+ * front of other queues, so uneven task sizes (e.g. 40-move vs 70-move
+ * puzzles) still keep every core busy.
+ */
+class WorkStealingPool
+{
+public:
+    // threadCount == 0 uses one worker per hardware thread
+    explicit WorkStealingPool(unsigned threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    // Queue a task; may be called from any thread, including workers
+    void submit(std::function<void()> task);
+
+    // Block until every submitted task has finished
+    void wait();
+
+    unsigned size() const { return static_cast<unsigned>(m_threads.size()); }
+
+    // Tasks taken from another worker's queue since construction
+    std::uint64_t stealCount() const { return m_steals.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void run(unsigned index);
+    bool popLocal(unsigned index, std::function<void()> &task);
+    bool steal(unsigned index, std::function<void()> &task);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_stateMutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_allDone;
+    std::atomic<std::int64_t> m_queued{0};   // tasks waiting in any queue (may dip below 0 briefly)
+    std::atomic<std::uint64_t> m_pending{0}; // tasks queued or running
+    std::atomic<std::uint64_t> m_steals{0};
+    std::atomic<unsigned> m_nextWorker{0};
+    bool m_stopping = false;
+};
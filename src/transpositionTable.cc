@@ -0,0 +1,90 @@
+#include "transpositionTable.hh"
+
+namespace
+{
+    // Low 16 bits hold the bound and entry direction, the rest the top of the hash
+    constexpr std::uint64_t HASH_BITS = ~std::uint64_t{0xFFFF};
+
+    constexpr std::uint64_t packData(std::uint64_t hash, int bound, int prevBlank)
+    {
+        return (hash & HASH_BITS) | static_cast<std::uint64_t>(bound) | static_cast<std::uint64_t>(prevBlank + 1) << 8;
+    }
+
+    constexpr int boundOf(std::uint64_t data) { return static_cast<int>(data & 0xFF); }
+
+    // Data was stored under this hash for the same entry direction
+    constexpr bool matches(std::uint64_t data, std::uint64_t hash, int prevBlank)
+    {
+        return (data & ~std::uint64_t{0xFF}) == packData(hash, 0, prevBlank);
+    }
+}
+
+TranspositionTable::TranspositionTable(std::size_t budgetBytes)
+{
+    m_bucketCount = 1;
+    while (m_bucketCount * 2 * sizeof(Bucket) <= budgetBytes)
+        m_bucketCount *= 2;
+    m_buckets = std::make_unique<Bucket[]>(m_bucketCount);
+}
+
+int TranspositionTable::probe(std::uint64_t hash, PackedBoard board, int prevBlank) const
+{
+    const Bucket &bucket = m_buckets[hash & (m_bucketCount - 1)];
+    for (const Entry &entry : bucket.entries)
+    {
+        const std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+        const std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == board && matches(data, hash, prevBlank))
+            return boundOf(data);
+    }
+    return 0;
+}
+
+void TranspositionTable::store(std::uint64_t hash, PackedBoard board, int prevBlank, int bound)
+{
+    Bucket &bucket = m_buckets[hash & (m_bucketCount - 1)];
+    Entry *victim = &bucket.entries[0];
+    int victimBound = 256;
+    for (Entry &entry : bucket.entries)
+    {
+        const std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+        const std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == board && (data & HASH_BITS) == (hash & HASH_BITS))
+        {
+            // Same state: keep the tighter bound of the same entry direction
+            if (matches(data, hash, prevBlank) && boundOf(data) >= bound)
+                return;
+            victim = &entry;
+            break;
+        }
+        const int stored = check == 0 && data == 0 ? -1 : boundOf(data);
+        if (stored < victimBound)
+        {
+            victim = &entry;
+            victimBound = stored;
+        }
+    }
+
+    const std::uint64_t data = packData(hash, bound > 255 ? 255 : bound, prevBlank);
+    victim->data.store(data, std::memory_order_relaxed);
+    victim->check.store(board ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+    for (std::size_t b = 0; b < m_bucketCount; ++b)
+        for (Entry &entry : m_buckets[b].entries)
+        {
+            entry.data.store(0, std::memory_order_relaxed);
+            entry.check.store(0, std::memory_order_relaxed);
+        }
+}
+
+std::size_t TranspositionTable::occupied() const
+{
+    std::size_t count = 0;
+    for (std::size_t b = 0; b < m_bucketCount; ++b)
+        for (const Entry &entry : m_buckets[b].entries)
+            count += entry.data.load(std::memory_order_relaxed) != 0;
+    return count;
+}
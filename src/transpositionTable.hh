@@ -0,0 +1,123 @@
+#pragma once
+
+#include "packedBoard.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Zobrist keys for the 4x4 board: one random word per (tile, cell).
+ *
+ * The hash of a board is the XOR of the keys of its tiles (the blank adds
+ * nothing, its cell follows from the others), so a move updates it with two
+ * XORs instead of rehashing the board.
+ */
+struct ZobristKeys
+{
+    std::uint64_t key[PACKED_CELLS][PACKED_CELLS]; // [tile][cell]
+};
+
+constexpr ZobristKeys makeZobristKeys()
+{
+    ZobristKeys keys{};
+    std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (int tile = 1; tile < PACKED_CELLS; ++tile)
+        for (int cell = 0; cell < PACKED_CELLS; ++cell)
+        {
+            // splitmix64
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            keys.key[tile][cell] = z ^ (z >> 31);
+        }
+    return keys;
+}
+
+inline constexpr ZobristKeys ZOBRIST = makeZobristKeys();
+
+constexpr std::uint64_t zobristHash(PackedBoard board)
+{
+    std::uint64_t hash = 0;
+    for (int cell = 0; cell < PACKED_CELLS; ++cell)
+        hash ^= ZOBRIST.key[packedTile(board, cell)][cell];
+    return hash;
+}
+
+// Hash after `tile` slid from cell `from` to cell `to`
+constexpr std::uint64_t zobristMove(std::uint64_t hash, int tile, int from, int to)
+{
+    return hash ^ ZOBRIST.key[tile][from] ^ ZOBRIST.key[tile][to];
+}
+
+/**
+ * Fixed-size table of lower bounds learned by IDA*, shared by every search.
+ *
+ * When the subtree below a state fails to reach the goal within the
+ * threshold, the smallest f that exceeded it, minus the state's g, is a
+ * lower bound on the moves left - often well above the heuristic. The
+ * bound only covers paths that do not start by undoing the incoming move
+ * (the search prunes those), so entries are keyed by the board *and* the
+ * cell the blank came from. The goal never changes, so bounds stay valid
+ * across iterations and across puzzles.
+ *
+ * Buckets are one cache line of four entries, indexed by the Zobrist hash;
+ * the full packed board is kept, so there are no false hits from a clean
+ * read. Entries are written without locks as (board ^ data, data), the
+ * usual lockless-hashing scheme, so any number of threads can probe and
+ * store concurrently. The check is probabilistic: a read whose two words
+ * come from different writes still decodes to some board. Data carries the
+ * top 48 bits of the hash as well, so such a torn read only passes if that
+ * garbage board is the probed one *and* the stray hash bits match its hash;
+ * otherwise it is treated as a miss. A store replaces the
+ * entry of the same state, or else the one with the smallest bound (the
+ * cheapest subtree to search again).
+ */
+class TranspositionTable
+{
+public:
+    // Largest power-of-two number of buckets that fits the budget (at least one)
+    explicit TranspositionTable(std::size_t budgetBytes);
+
+    /**
+     * Stored lower bound for a state.
+     *
+     * @param hash      Zobrist hash of board.
+     * @param board     State to look up.
+     * @param prevBlank Cell the blank came from (-1 at the root).
+     * @return Moves left are at least this many, or 0 if nothing is stored.
+     */
+    int probe(std::uint64_t hash, PackedBoard board, int prevBlank) const;
+
+    // Record that board (entered from prevBlank) needs at least `bound` more moves
+    void store(std::uint64_t hash, PackedBoard board, int prevBlank, int bound);
+
+    // Forget every entry (not thread-safe against concurrent searches)
+    void clear();
+
+    std::size_t capacity() const { return m_bucketCount * ENTRIES_PER_BUCKET; }
+    std::size_t bytes() const { return m_bucketCount * sizeof(Bucket); }
+
+    // Entries currently holding a state (scans the whole table)
+    std::size_t occupied() const;
+
+private:
+    static constexpr int ENTRIES_PER_BUCKET = 4;
+
+    struct Entry
+    {
+        std::atomic<std::uint64_t> check{0}; // board ^ data
+        std::atomic<std::uint64_t> data{0};  // hash top bits | (prevBlank + 1) << 8 | bound
+    };
+
+    struct alignas(64) Bucket
+    {
+        Entry entries[ENTRIES_PER_BUCKET];
+    };
+
+    static_assert(sizeof(Bucket) == 64);
+
+    std::unique_ptr<Bucket[]> m_buckets;
+    std::size_t m_bucketCount = 0;
+};
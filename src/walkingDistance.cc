@@ -0,0 +1,126 @@
+#include "walkingDistance.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace
+{
+    constexpr int SIDE = WalkingDistance::SIDE;
+    constexpr int COUNT_BITS = 3;              // a line holds 0-4 tiles of one group
+    constexpr int BLANK_SHIFT = SIDE * SIDE * COUNT_BITS;
+
+    int countAt(std::uint64_t key, int line, int group)
+    {
+        return static_cast<int>((key >> ((line * SIDE + group) * COUNT_BITS)) & 7);
+    }
+
+    std::uint64_t addCount(std::uint64_t key, int line, int group, int delta)
+    {
+        const int shift = (line * SIDE + group) * COUNT_BITS;
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(key) + (static_cast<std::int64_t>(delta) << shift));
+    }
+
+    int blankLine(std::uint64_t key) { return static_cast<int>(key >> BLANK_SHIFT); }
+
+    std::uint64_t withBlank(std::uint64_t key, int line)
+    {
+        return (key & ((std::uint64_t(1) << BLANK_SHIFT) - 1)) | (std::uint64_t(line) << BLANK_SHIFT);
+    }
+
+    // Counts of a board along one axis: line(cell) is the row or column, group(tile) the goal line
+    template <typename Line, typename Group>
+    std::uint64_t keyOf(const std::array<int, 16> &board, Line line, Group group)
+    {
+        std::uint64_t key = 0;
+        for (int cell = 0; cell < SIDE * SIDE; ++cell)
+            key = board[cell] == 0 ? withBlank(key, line(cell)) : addCount(key, line(cell), group(board[cell]), 1);
+        return key;
+    }
+}
+
+const WalkingDistance &WalkingDistance::instance()
+{
+    static const WalkingDistance table;
+    return table;
+}
+
+/**
+ * Enumerate every row state by BFS from the goal and record the successor
+ * of each state for every move, so distances and transitions come from the
+ * same pass.
+ */
+WalkingDistance::WalkingDistance()
+{
+    // Goal: every line holds its own four tiles, the blank sits in the last one
+    std::uint64_t goal = withBlank(0, SIDE - 1);
+    for (int line = 0; line < SIDE; ++line)
+        goal = addCount(goal, line, line, line == SIDE - 1 ? SIDE - 1 : SIDE);
+
+    std::vector<Key> keys{goal};
+    std::unordered_map<Key, int> index{{goal, 0}};
+    m_distance.push_back(0);
+
+    for (std::size_t state = 0; state < keys.size(); ++state)
+    {
+        const Key key = keys[state];
+        const int blank = blankLine(key);
+        for (int forward = 0; forward < 2; ++forward)
+        {
+            const int from = blank + (forward ? 1 : -1); // line the moving tile comes from
+            for (int group = 0; group < SIDE; ++group)
+            {
+                int successor = static_cast<int>(state); // impossible moves are never asked for
+                if (from >= 0 && from < SIDE && countAt(key, from, group) > 0)
+                {
+                    const Key next = withBlank(addCount(addCount(key, from, group, -1), blank, group, 1), from);
+                    auto [it, inserted] = index.emplace(next, static_cast<int>(keys.size()));
+                    if (inserted)
+                    {
+                        keys.push_back(next);
+                        m_distance.push_back(static_cast<std::uint8_t>(m_distance[state] + 1));
+                    }
+                    successor = it->second;
+                }
+                m_next.push_back(static_cast<std::uint16_t>(successor));
+            }
+        }
+    }
+    m_maxDistance = m_distance.back();
+
+    // Sorted copy of the keys for the one lookup at the start of every search
+    std::vector<std::uint16_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b)
+              { return keys[a] < keys[b]; });
+    m_sortedKeys.reserve(keys.size());
+    for (int state : order)
+        m_sortedKeys.push_back(keys[state]);
+    m_sortedStates = std::move(order);
+}
+
+int WalkingDistance::stateOf(Key key) const
+{
+    const auto it = std::lower_bound(m_sortedKeys.begin(), m_sortedKeys.end(), key);
+    return m_sortedStates[it - m_sortedKeys.begin()];
+}
+
+int WalkingDistance::rowState(const std::array<int, 16> &board) const
+{
+    return stateOf(keyOf(board, [](int cell)
+                         { return cell / SIDE; }, [](int tile)
+                         { return (tile - 1) / SIDE; }));
+}
+
+int WalkingDistance::columnState(const std::array<int, 16> &board) const
+{
+    return stateOf(keyOf(board, [](int cell)
+                         { return cell % SIDE; }, [](int tile)
+                         { return (tile - 1) % SIDE; }));
+}
+
+std::size_t WalkingDistance::memoryBytes() const
+{
+    return m_distance.size() * sizeof(m_distance[0]) + m_next.size() * sizeof(m_next[0]) +
+           m_sortedKeys.size() * sizeof(m_sortedKeys[0]) + m_sortedStates.size() * sizeof(m_sortedStates[0]);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Walking-distance table for the 4x4 puzzle (after Ken'ichiro Takahashi).
+ *
+ * A row state counts, for every board row, how many tiles of each goal row
+ * it holds (a 4x4 matrix whose rows sum to 4, except the blank's row, which
+ * sums to 3). A vertical move takes one tile from a row next to the blank
+ * into the blank's row, so the state graph can be searched by BFS from the
+ * goal: distance() is the least number of vertical moves that can sort every
+ * tile into its goal row, regardless of columns. Columns are the same
+ * problem transposed (tile t's goal column plays the role of its goal row),
+ * so one table serves both, and rows + columns is an admissible estimate
+ * that dominates the Manhattan distance.
+ *
+ * There are 24964 states. Each keeps its distance and its successor for
+ * every (blank direction, group of the moved tile), so a solver move is one
+ * table read instead of recounting the board.
+ */
+class WalkingDistance
+{
+public:
+    static constexpr int SIDE = 4;
+
+    // Shared table, built on first use (a few milliseconds, thread-safe)
+    static const WalkingDistance &instance();
+
+    // State of the board's rows (tile t belongs to goal row (t - 1) / 4)
+    int rowState(const std::array<int, 16> &board) const;
+
+    // State of the board's columns (tile t belongs to goal column (t - 1) % 4)
+    int columnState(const std::array<int, 16> &board) const;
+
+    // Fewest moves along one axis that bring every tile to its goal line
+    int distance(int state) const { return m_distance[state]; }
+
+    /**
+     * Successor after one move along the table's axis.
+     *
+     * @param state         Current row (or column) state.
+     * @param blankForward  The blank moved to the next row (column) down (right).
+     * @param group         Goal row (column) of the tile that moved.
+     * @return New state.
+     */
+    int step(int state, bool blankForward, int group) const
+    {
+        return m_next[(state * 2 + blankForward) * SIDE + group];
+    }
+
+    int stateCount() const { return static_cast<int>(m_distance.size()); }
+    int maxDistance() const { return m_maxDistance; }
+
+    // Bytes of every table the solver reads (distances, successors, state lookup)
+    std::size_t memoryBytes() const;
+
+private:
+    WalkingDistance();
+
+    // 4x4 counts (3 bits each) packed with the blank row (2 bits) into one key
+    using Key = std::uint64_t;
+    int stateOf(Key key) const;
+
+    std::vector<std::uint8_t> m_distance;
+    std::vector<std::uint16_t> m_next; // [state][blankForward][group]
+    std::vector<Key> m_sortedKeys;     // keys in ascending order, for stateOf()
+    std::vector<std::uint16_t> m_sortedStates;
+    int m_maxDistance = 0;
+};
@@ -0,0 +1,271 @@
+// Headless batch solver: optimal solutions for many positions on all cores.
+//
+// Usage: Puzzle15_batch [--threads N] [--pdb file.pdb] [--heuristic md|wd|pdb] [--tt MB] [--archive out.mv] [input.txt]
+//
+// --heuristic picks the solver estimate: md = Manhattan + linear conflict,
+// wd = walking distance, pdb = the pattern database (default; falls back to
+// md when the file cannot be loaded). --tt shares a transposition table of
+// the given size between all workers and reports its hit rate. --archive
+// also writes every solution as a 2-bit move record (moveCodec.hh, input
+// order) for Puzzle15_validate.
+//
+// Input (file or stdin): one position per line, 16 numbers in row-major
+// order with 0 for the empty cell. Empty lines and lines starting with '#'
+// are skipped.
+//
+// Output (stdout, in input order, streamed as soon as the prefix is ready):
+//   <line>\t<optimal length>\t<nodes expanded>\t<milliseconds>
+// Lines that are malformed or unsolvable print "invalid" / "unsolvable".
+// A throughput summary is written to stderr at the end.
+
+#include "moveCodec.hh"
+#include "patternDB.hh"
+#include "solver.hh"
+#include "threadPool.hh"
+#include "transpositionTable.hh"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Emits results strictly in submission order while workers finish out of order
+    class OrderedWriter
+    {
+    public:
+        explicit OrderedWriter(std::ostream &out) : out(out) {}
+
+        void publish(std::uint64_t sequence, std::string text)
+        {
+            std::lock_guard lock(mutex);
+            ready.emplace(sequence, std::move(text));
+            while (!ready.empty() && ready.begin()->first == next)
+            {
+                out << ready.begin()->second;
+                ready.erase(ready.begin());
+                ++next;
+            }
+            out.flush();
+            flushed.notify_all();
+        }
+
+        // Block until fewer than `limit` results are outstanding (bounds memory on huge inputs)
+        void throttle(std::uint64_t submitted, std::uint64_t limit)
+        {
+            std::unique_lock lock(mutex);
+            flushed.wait(lock, [&]
+                         { return submitted - next < limit; });
+        }
+
+    private:
+        std::ostream &out;
+        std::mutex mutex;
+        std::condition_variable flushed;
+        std::map<std::uint64_t, std::string> ready;
+        std::uint64_t next = 0;
+    };
+
+    struct Totals
+    {
+        std::mutex mutex;
+        std::uint64_t solved = 0;
+        std::uint64_t nodes = 0;
+        double searchSeconds = 0.0;
+        std::uint64_t probes = 0, hits = 0, cutoffs = 0; // transposition table
+    };
+
+    // Whole non-negative number (no sign, no trailing text)
+    bool parseCount(const std::string &text, std::size_t &value)
+    {
+        const char *end = text.data() + text.size();
+        const auto [last, error] = std::from_chars(text.data(), end, value);
+        return !text.empty() && error == std::errc() && last == end;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned threads = 0;
+    std::string pdbPath = "assets/pdb/puzzle15-663.pdb";
+    std::string heuristic = "pdb";
+    std::size_t tableMegabytes = 0;
+    std::string archivePath;
+    std::string inputPath;
+
+    auto usage = [&]
+    {
+        std::cerr << "Usage: " << argv[0] << " [--threads N] [--pdb file.pdb] [--heuristic md|wd|pdb] [--tt MB] [--archive out.mv] [input.txt]\n";
+    };
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        std::size_t number = 0;
+        if ((arg == "--threads" || arg == "--tt") && i + 1 < argc)
+        {
+            if (!parseCount(argv[++i], number))
+            {
+                std::cerr << "Invalid " << arg << " value '" << argv[i] << "'\n";
+                usage();
+                return 1;
+            }
+            if (arg == "--threads")
+                threads = static_cast<unsigned>(std::min<std::size_t>(number, 1024)); // 0 = all cores
+            else
+                tableMegabytes = number;
+        }
+        else if (arg == "--pdb" && i + 1 < argc)
+            pdbPath = argv[++i];
+        else if (arg == "--heuristic" && i + 1 < argc)
+        {
+            heuristic = argv[++i];
+            if (heuristic != "md" && heuristic != "wd" && heuristic != "pdb")
+            {
+                std::cerr << "Unknown heuristic '" << heuristic << "'\n";
+                usage();
+                return 1;
+            }
+        }
+        else if (arg == "--archive" && i + 1 < argc)
+            archivePath = argv[++i];
+        else if (arg == "--help" || arg == "-h")
+        {
+            usage();
+            return 0;
+        }
+        else
+            inputPath = arg;
+    }
+
+    std::ifstream file;
+    if (!inputPath.empty())
+    {
+        file.open(inputPath);
+        if (!file)
+        {
+            std::cerr << "Cannot open " << inputPath << "\n";
+            return 1;
+        }
+    }
+    std::istream &input = inputPath.empty() ? std::cin : file;
+
+    std::ofstream archive;
+    if (!archivePath.empty())
+    {
+        archive.open(archivePath, std::ios::binary | std::ios::trunc);
+        if (!archive)
+        {
+            std::cerr << "Cannot create " << archivePath << "\n";
+            return 1;
+        }
+    }
+
+    // One read-only mapping shared by every worker
+    PatternDatabase patterns;
+    SolverOptions options;
+    if (heuristic == "wd")
+    {
+        options.heuristic = SolverHeuristic::WalkingDistance;
+        std::cerr << "Using walking distance (" << heuristicTableBytes(options) << " bytes of tables)\n";
+    }
+    else if (heuristic == "md")
+        std::cerr << "Using Manhattan + linear conflict\n";
+    else if (patterns.load(pdbPath))
+    {
+        options.heuristic = SolverHeuristic::PatternDatabase;
+        options.patterns = &patterns;
+        std::cerr << "Using " << patterns.describe() << " pattern database " << pdbPath << "\n";
+    }
+    else
+        std::cerr << "No pattern database at " << pdbPath << ", using Manhattan + linear conflict\n";
+
+    // Bounds learned on one position also prune the others, so every worker shares one table
+    std::unique_ptr<TranspositionTable> transpositions;
+    if (tableMegabytes > 0)
+    {
+        transpositions = std::make_unique<TranspositionTable>(tableMegabytes << 20);
+        options.transpositions = transpositions.get();
+        std::cerr << "Transposition table: " << transpositions->capacity() << " entries ("
+                  << (transpositions->bytes() >> 20) << " MB)\n";
+    }
+
+    WorkStealingPool pool(threads);
+    OrderedWriter writer(std::cout);
+    OrderedWriter archiveWriter(archive); // records in input order; unused without --archive
+    Totals totals;
+    std::cerr << "Solving on " << pool.size() << " threads\n";
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t inFlightLimit = pool.size() * 64ull;
+    std::uint64_t sequence = 0;
+    std::string line;
+    for (std::uint64_t lineNumber = 1; std::getline(input, line); ++lineNumber)
+    {
+        if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
+        writer.throttle(sequence, inFlightLimit);
+        pool.submit([&, lineNumber, line, seq = sequence]
+                    {
+                        std::ostringstream out;
+                        out << lineNumber << '\t';
+                        std::vector<unsigned char> record;
+
+                        std::array<int, 16> board;
+                        if (!parseBoard(line, board))
+                            out << "invalid\n";
+                        else
+                        {
+                            int emptyIdx = 0;
+                            while (board[emptyIdx] != 0)
+                                ++emptyIdx;
+
+                            SolverResult result = solvePuzzle(board, emptyIdx, options);
+                            if (!result.solved)
+                                out << "unsolvable\n";
+                            else
+                            {
+                                out << result.moves.size() << '\t' << result.stats.nodesExpanded << '\t'
+                                    << result.stats.seconds * 1000.0 << '\n';
+                                if (archive.is_open())
+                                    encodeMoves(4, board, result.moves, record);
+
+                                std::lock_guard lock(totals.mutex);
+                                ++totals.solved;
+                                totals.nodes += result.stats.nodesExpanded;
+                                totals.searchSeconds += result.stats.seconds;
+                                totals.probes += result.stats.transpositionProbes;
+                                totals.hits += result.stats.transpositionHits;
+                                totals.cutoffs += result.stats.transpositionCutoffs;
+                            }
+                        }
+                        if (archive.is_open())
+                            archiveWriter.publish(seq, std::string(record.begin(), record.end()));
+                        writer.publish(seq, out.str()); });
+        ++sequence;
+    }
+
+    pool.wait();
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cerr << "Solved " << totals.solved << " of " << sequence << " positions in " << wall << " s ("
+              << (wall > 0 ? sequence / wall : 0.0) << " positions/s, "
+              << (wall > 0 ? totals.nodes / wall : 0.0) << " nodes/s, "
+              << (wall > 0 ? totals.searchSeconds / wall : 0.0) << " average concurrency, "
+              << pool.stealCount() << " steals)\n";
+    if (transpositions)
+        std::cerr << "Transposition table: " << totals.probes << " probes, "
+                  << (totals.probes ? 100.0 * totals.hits / totals.probes : 0.0) << "% hits, " << totals.cutoffs
+                  << " cutoffs, " << transpositions->occupied() << " of " << transpositions->capacity()
+                  << " entries used\n";
+    return 0;
+}
@@ -0,0 +1,470 @@
+// Regression benchmarks of the core paths, written as JSON.
+//
+// Usage: puzzle15_bench [--quick] [--filter text] [--pdb file.pdb] [--korf data/korf100.txt]
+//                       [--font file.ttf] [--output results.json]
+//
+// Covers shuffleBoard(), moveTile() and isSolved() for every board size, the
+// solver heuristics (Manhattan + linear conflict, walking distance, pattern
+// database, batch SIMD per instruction set), IDA* per heuristic on the
+// easiest Korf instances, the 3x3 distance table and, when built with SFML,
+// drawBoard() and BoardRenderer frames into an sf::RenderTexture. --filter
+// keeps the benchmarks whose name contains the text; --quick shortens every
+// sample (for CI smoke runs, too noisy to compare). The exit code is 2 if
+// any solver returned a solution of the wrong length for a Korf instance.
+//
+// Each benchmark repeats its body until a sample lasts long enough, takes
+// several samples and reports the median and fastest time per operation.
+// Solver entries also carry the nodes expanded, which do not depend on the
+// machine and catch search regressions exactly. Output (stdout or --output):
+//   {"version": 1, "quick": false, "simd": "AVX2", "hardware_threads": 8, "compiler": "...",
+//    "benchmarks": [{"name": "board/shuffle/4x4", "ns_per_op": 41.2, "min_ns_per_op": 40.8,
+//                    "ops": 1048576, "samples": 5, "nodes": ...}, ...]}
+
+#include "board.hh"
+#include "distanceTable.hh"
+#include "patternDB.hh"
+#include "simdHeuristics.hh"
+#include "solver.hh"
+#include "walkingDistance.hh"
+
+#ifdef PUZZLE15_BENCH_RENDER
+#include "boardRenderer.hh"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    struct BenchResult
+    {
+        std::string name;
+        double nsPerOp = 0.0;
+        double minNsPerOp = 0.0;
+        std::uint64_t ops = 0; // operations timed over all samples
+        int samples = 0;
+        std::vector<std::pair<std::string, double>> extra; // benchmark-specific counters
+    };
+
+    class BenchSuite
+    {
+    public:
+        BenchSuite(bool quick, std::string filter) : m_quick(quick), m_filter(std::move(filter)) {}
+
+        bool quick() const { return m_quick; }
+        bool wants(const std::string &name) const { return name.find(m_filter) != std::string::npos; }
+
+        /**
+         * Time body() (which performs opsPerCall operations and returns a checksum).
+         *
+         * The repetition count is calibrated on the first sample so each sample
+         * lasts at least the minimum sample time; slow bodies (solver runs)
+         * therefore run once per sample.
+         */
+        template <typename Body>
+        BenchResult &measure(const std::string &name, std::uint64_t opsPerCall, Body &&body)
+        {
+            using Clock = std::chrono::steady_clock;
+            const double minSample = m_quick ? 0.01 : 0.1;
+            const int sampleCount = m_quick ? 3 : 5;
+
+            std::uint64_t calls = 0;
+            std::vector<double> perOp;
+            const auto calibration = Clock::now();
+            double elapsed = 0.0;
+            do
+            {
+                m_sink = m_sink + body();
+                ++calls;
+                elapsed = std::chrono::duration<double>(Clock::now() - calibration).count();
+            } while (elapsed < minSample);
+            perOp.push_back(elapsed * 1e9 / (calls * opsPerCall));
+
+            for (int sample = 1; sample < sampleCount; ++sample)
+            {
+                const auto start = Clock::now();
+                for (std::uint64_t call = 0; call < calls; ++call)
+                    m_sink = m_sink + body();
+                perOp.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (calls * opsPerCall));
+            }
+
+            std::sort(perOp.begin(), perOp.end());
+            BenchResult result;
+            result.name = name;
+            result.nsPerOp = perOp[perOp.size() / 2];
+            result.minNsPerOp = perOp.front();
+            result.ops = calls * opsPerCall * sampleCount;
+            result.samples = sampleCount;
+            return add(std::move(result));
+        }
+
+        BenchResult &add(BenchResult result)
+        {
+            std::cerr << result.name << ": " << result.nsPerOp << " ns/op\n";
+            m_results.push_back(std::move(result));
+            return m_results.back();
+        }
+
+        void writeJson(std::ostream &out) const
+        {
+            out << "{\n  \"version\": 1,\n  \"quick\": " << (m_quick ? "true" : "false")
+                << ",\n  \"simd\": \"" << simdLevelName(detectSimdLevel())
+                << "\",\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+                << ",\n  \"compiler\": \"" << compilerName() << "\",\n  \"benchmarks\": [";
+            for (std::size_t i = 0; i < m_results.size(); ++i)
+            {
+                const BenchResult &result = m_results[i];
+                out << (i ? ",\n" : "\n") << "    {\"name\": \"" << result.name << "\", \"ns_per_op\": " << result.nsPerOp
+                    << ", \"min_ns_per_op\": " << result.minNsPerOp << ", \"ops\": " << result.ops
+                    << ", \"samples\": " << result.samples;
+                for (const auto &[key, value] : result.extra)
+                    out << ", \"" << key << "\": " << value;
+                out << "}";
+            }
+            out << "\n  ]\n}\n";
+        }
+
+        std::uint64_t checksum() const { return m_sink; }
+
+    private:
+        static std::string compilerName()
+        {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc " + std::to_string(_MSC_VER);
+#else
+            return "unknown";
+#endif
+        }
+
+        bool m_quick;
+        std::string m_filter;
+        std::vector<BenchResult> m_results;
+        volatile std::uint64_t m_sink = 0; // keeps the timed results observable
+    };
+
+    template <int N>
+    void benchBoard(BenchSuite &suite)
+    {
+        const std::string suffix = std::to_string(N) + "x" + std::to_string(N);
+        constexpr int BATCH = 256;
+        RandomEngine rng(N);
+
+        if (suite.wants("board/shuffle/" + suffix))
+        {
+            Board<N> board;
+            suite.measure("board/shuffle/" + suffix, BATCH, [&]
+                          {
+                              std::uint64_t sum = 0;
+                              for (int i = 0; i < BATCH; ++i)
+                              {
+                                  shuffleBoard(board, rng);
+                                  sum += board.emptyIdx;
+                              }
+                              return sum; });
+        }
+
+        // Random clicks next to and away from the blank, as a player would produce
+        if (suite.wants("board/moveTile/" + suffix))
+        {
+            std::vector<std::pair<int, int>> clicks(4096);
+            for (auto &[x, y] : clicks)
+                x = static_cast<int>(rng() % N), y = static_cast<int>(rng() % N);
+            Board<N> board;
+            std::size_t next = 0;
+            suite.measure("board/moveTile/" + suffix, BATCH, [&]
+                          {
+                              std::uint64_t moved = 0;
+                              for (int i = 0; i < BATCH; ++i)
+                              {
+                                  const auto [x, y] = clicks[next++ % clicks.size()];
+                                  const int empty = board.emptyIdx;
+                                  // Half the clicks land next to the blank so both outcomes are timed
+                                  moved += i % 2 ? moveTile(board, x, y)
+                                                 : moveTile(board, empty % N + (empty % N ? -1 : 1), empty / N);
+                              }
+                              return moved; });
+        }
+
+        if (suite.wants("board/isSolved/" + suffix))
+        {
+            std::vector<Board<N>> boards(BATCH);
+            for (std::size_t i = 0; i < boards.size(); ++i)
+                if (i % 8) // every eighth board stays solved
+                    shuffleBoard(boards[i], rng);
+            suite.measure("board/isSolved/" + suffix, BATCH, [&]
+                          {
+                              std::uint64_t solved = 0;
+                              for (const Board<N> &board : boards)
+                                  solved += isSolved(board);
+                              return solved; });
+        }
+    }
+
+    struct KorfInstance
+    {
+        std::array<int, 16> board;
+        int emptyIdx;
+        int length;
+    };
+
+    // The `count` shortest Korf instances (by the optimal length in each line's comment)
+    std::vector<KorfInstance> easiestKorf(const std::string &path, std::size_t count)
+    {
+        std::vector<KorfInstance> instances;
+        std::ifstream input(path);
+        std::string line;
+        while (std::getline(input, line))
+        {
+            KorfInstance instance;
+            const std::size_t comment = line.find('#');
+            if (line.empty() || comment == 0 || comment == std::string::npos || !parseBoard(line, instance.board))
+                continue;
+            instance.emptyIdx = static_cast<int>(std::find(instance.board.begin(), instance.board.end(), 0) - instance.board.begin());
+            instance.length = std::stoi(line.substr(line.find_last_of(' ') + 1));
+            instances.push_back(instance);
+        }
+        std::stable_sort(instances.begin(), instances.end(), [](const KorfInstance &a, const KorfInstance &b)
+                         { return a.length < b.length; });
+        instances.resize(std::min(count, instances.size()));
+        return instances;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    bool quick = false;
+    std::string filter;
+    std::string pdbPath = "assets/pdb/puzzle15-663.pdb";
+    std::string korfPath = "data/korf100.txt";
+    std::string fontPath = "assets/fonts/Montserrat-Bold.ttf";
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--quick")
+            quick = true;
+        else if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--pdb" && i + 1 < argc)
+            pdbPath = argv[++i];
+        else if (arg == "--korf" && i + 1 < argc)
+            korfPath = argv[++i];
+        else if (arg == "--font" && i + 1 < argc)
+            fontPath = argv[++i];
+        else if (arg == "--output" && i + 1 < argc)
+            outputPath = argv[++i];
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--quick] [--filter text] [--pdb file.pdb] [--korf data/korf100.txt]"
+                      << " [--font file.ttf] [--output results.json]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    BenchSuite suite(quick, filter);
+
+    // Board logic, one instantiation per size
+    benchBoard<3>(suite);
+    benchBoard<4>(suite);
+    benchBoard<5>(suite);
+    benchBoard<6>(suite);
+    benchBoard<7>(suite);
+    benchBoard<8>(suite);
+
+    // Heuristics on the same random 4x4 positions
+    RandomEngine rng(15);
+    std::vector<std::array<int, 16>> positions(1024);
+    std::vector<PackedBoard> packed(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        Board<4> board;
+        shuffleBoard(board, rng);
+        positions[i] = board.tiles;
+        packed[i] = packBoard(board.tiles);
+    }
+    const std::uint64_t positionCount = positions.size();
+
+    if (suite.wants("heuristic/manhattan+lc"))
+        suite.measure("heuristic/manhattan+lc", positionCount, [&]
+                      {
+                          std::uint64_t sum = 0;
+                          for (const auto &board : positions)
+                              sum += manhattanDistance(board) + linearConflict(board);
+                          return sum; });
+
+    if (suite.wants("heuristic/walking-distance"))
+    {
+        const WalkingDistance &walking = WalkingDistance::instance();
+        suite.measure("heuristic/walking-distance", positionCount, [&]
+                      {
+                          std::uint64_t sum = 0;
+                          for (const auto &board : positions)
+                              sum += walking.distance(walking.rowState(board)) + walking.distance(walking.columnState(board));
+                          return sum; });
+    }
+
+    PatternDatabase patterns;
+    const bool havePatterns = patterns.load(pdbPath);
+    if (!havePatterns)
+        std::cerr << "No pattern database at " << pdbPath << ", skipping the pdb benchmarks\n";
+    if (havePatterns && suite.wants("heuristic/pdb"))
+        suite.measure("heuristic/pdb", positionCount, [&]
+                      {
+                          std::uint64_t sum = 0;
+                          for (const auto &board : positions)
+                              sum += patterns.estimate(board);
+                          return sum; });
+
+    std::vector<BoardEstimate> estimates(packed.size());
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2})
+    {
+        const std::string name = std::string("heuristic/simd-batch/") + simdLevelName(level);
+        if (level < detectSimdLevel() || !suite.wants(name))
+            continue;
+        suite.measure(name, positionCount, [&]
+                      {
+                          evaluateBoards(packed, estimates, level);
+                          return std::uint64_t(estimates[0].manhattan); });
+    }
+
+    // Full IDA* searches; node counts are exact, so they are compared before times
+    const std::vector<KorfInstance> korf = easiestKorf(korfPath, quick ? 2 : 4);
+    int wrongLengths = 0; // over all heuristics: optimality regressions fail the run
+    if (korf.empty())
+        std::cerr << "No Korf instances at " << korfPath << ", skipping the solver benchmarks\n";
+    for (const char *heuristic : {"md", "wd", "pdb"})
+    {
+        const std::string name = std::string("solver/ida/") + heuristic;
+        SolverOptions options;
+        if (std::string(heuristic) == "wd")
+            options.heuristic = SolverHeuristic::WalkingDistance;
+        else if (std::string(heuristic) == "pdb")
+        {
+            if (!havePatterns)
+                continue;
+            options.heuristic = SolverHeuristic::PatternDatabase;
+            options.patterns = &patterns;
+        }
+        if (korf.empty() || !suite.wants(name))
+            continue;
+
+        std::uint64_t nodes = 0;
+        int wrong = 0;
+        BenchResult &result = suite.measure(name, korf.size(), [&]
+                                            {
+                                                nodes = 0;
+                                                wrong = 0;
+                                                for (const KorfInstance &instance : korf)
+                                                {
+                                                    const SolverResult solved = solvePuzzle(instance.board, instance.emptyIdx, options);
+                                                    nodes += solved.stats.nodesExpanded;
+                                                    wrong += static_cast<int>(solved.moves.size()) != instance.length;
+                                                }
+                                                return nodes; });
+        result.extra = {{"positions", static_cast<double>(korf.size())},
+                        {"nodes", static_cast<double>(nodes)},
+                        {"nodes_per_second", result.nsPerOp > 0 ? nodes / (result.nsPerOp * korf.size() * 1e-9) : 0.0},
+                        {"wrong_lengths", static_cast<double>(wrong)}};
+        wrongLengths += wrong;
+    }
+
+    // 3x3: exact table (built once per op) and optimal solves from it
+    if (suite.wants("solver/distance-table/3x3"))
+    {
+        DistanceTable table;
+        suite.measure("solver/distance-table/3x3/build", 1, [&]
+                      {
+                          table.build(3, 3, 1);
+                          return table.stateCount(); });
+
+        std::vector<std::array<int, 9>> boards(256);
+        for (auto &board : boards)
+        {
+            Board<3> shuffled;
+            shuffleBoard(shuffled, rng);
+            board = shuffled.tiles;
+        }
+        std::vector<int> moves;
+        suite.measure("solver/distance-table/3x3/solve", boards.size(), [&]
+                      {
+                          std::uint64_t length = 0;
+                          for (const auto &board : boards)
+                              if (table.solve(board, moves))
+                                  length += moves.size();
+                          return length; });
+    }
+
+#ifdef PUZZLE15_BENCH_RENDER
+    // Offscreen frames at the game's layout (see main.cc), per board size
+    sf::Font font;
+    if (!font.openFromFile(fontPath))
+        std::cerr << "Cannot open font " << fontPath << ", skipping the render benchmarks\n";
+    else
+        for (int size = MIN_BOARD_SIZE; size <= MAX_BOARD_SIZE; ++size)
+        {
+            const std::string suffix = std::to_string(size) + "x" + std::to_string(size);
+            if (!suite.wants("render/drawBoard/" + suffix) && !suite.wants("render/boardRenderer/" + suffix))
+                continue;
+
+            PuzzleBoard board(size);
+            board.shuffle(rng);
+            const float boardScale = static_cast<float>(DEFAULT_BOARD_SIZE) / size;
+            const int frames = quick ? 30 : 300;
+            const RenderComparison cmp = compareBoardRendering(board, font, {2280, 1730}, 200.f, 240.f, 50.f,
+                                                               280.f * boardScale, 20.f * boardScale,
+                                                               static_cast<unsigned int>(80 * boardScale), frames);
+            if (cmp.frames == 0)
+            {
+                std::cerr << "Cannot create an offscreen render target, skipping the render benchmarks\n";
+                break;
+            }
+            auto frameResult = [&](const std::string &name, double ms, int drawCalls)
+            {
+                BenchResult result;
+                result.name = name;
+                result.nsPerOp = result.minNsPerOp = ms * 1e6;
+                result.ops = static_cast<std::uint64_t>(cmp.frames);
+                result.samples = 1;
+                result.extra = {{"draw_calls", static_cast<double>(drawCalls)},
+                                {"differing_pixels", static_cast<double>(cmp.differingPixels)}};
+                suite.add(std::move(result));
+            };
+            frameResult("render/drawBoard/" + suffix, cmp.legacyMs, cmp.legacyDrawCalls);
+            frameResult("render/boardRenderer/" + suffix, cmp.batchedMs, cmp.batchedDrawCalls);
+        }
+#else
+    (void)fontPath;
+    std::cerr << "Built without SFML, skipping the render benchmarks\n";
+#endif
+
+    if (outputPath.empty())
+        suite.writeJson(std::cout);
+    else
+    {
+        std::ofstream out(outputPath);
+        suite.writeJson(out);
+        if (!out)
+        {
+            std::cerr << "Cannot write " << outputPath << "\n";
+            return 1;
+        }
+    }
+    std::cerr << "checksum " << suite.checksum() << "\n";
+    if (wrongLengths > 0)
+    {
+        std::cerr << wrongLengths << " Korf solutions had the wrong length\n";
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,11 @@
+# Copies a directory at build time if it exists (run from POST_BUILD steps).
+#
+# Usage: cmake -DSOURCE=<dir> -DDESTINATION=<dir> -P copyIfPresent.cmake
+#
+# Optional generated assets (the pattern database) may be built after the
+# game, so whether they exist is only known when the copy runs, not when
+# CMake configures.
+
+if(IS_DIRECTORY ${SOURCE})
+    file(COPY ${SOURCE}/ DESTINATION ${DESTINATION})
+endif()
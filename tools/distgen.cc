@@ -0,0 +1,88 @@
+// Exact distance tables for small boards by full-state-space BFS.
+//
+// Usage: Puzzle15_dstgen [--threads N] [--histogram out.tsv] <rows>x<cols> [output.dst]
+//
+// Supported shapes have at most 12 cells: 3x3 (181,440 states, 45 KB),
+// 2x4 (20,160), 2x5 (1.8M), 3x4 (239.5M states, 60 MB, a couple of minutes
+// per core). The distance histogram is printed as "<distance>\t<states>"
+// (or written to --histogram) together with the build time and rate.
+
+#include "distanceTable.hh"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+    unsigned threads = 0;
+    std::string histogramPath;
+    std::string shape;
+    std::string output;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--histogram" && i + 1 < argc)
+            histogramPath = argv[++i];
+        else if (shape.empty())
+            shape = arg;
+        else
+            output = arg;
+    }
+
+    int rows = 0, cols = 0;
+    const std::size_t x = shape.find('x');
+    if (x != std::string::npos)
+    {
+        rows = std::atoi(shape.substr(0, x).c_str());
+        cols = std::atoi(shape.substr(x + 1).c_str());
+    }
+    if (!DistanceTable::supports(rows, cols))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--threads N] [--histogram out.tsv] <rows>x<cols> [output.dst]\n"
+                  << "Boards need 2+ rows and columns and at most " << DISTANCE_MAX_CELLS << " cells\n";
+        return 1;
+    }
+
+    DistanceTable table;
+    const auto start = std::chrono::steady_clock::now();
+    table.build(rows, cols, threads, &std::cerr);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::uint64_t reached = 0;
+    for (std::uint64_t count : table.histogram())
+        reached += count;
+    std::cerr << rows << "x" << cols << ": " << reached << " of " << table.stateCount() << " states reached, "
+              << "max distance " << table.maxDistance() << ", " << table.tableBytes() << " bytes, " << seconds
+              << " s (" << (seconds > 0 ? reached / seconds : 0.0) << " states/s)\n";
+
+    std::ofstream histogramFile;
+    if (!histogramPath.empty())
+        histogramFile.open(histogramPath);
+    std::ostream &histogram = histogramPath.empty() ? std::cout : histogramFile;
+    histogram << "# " << rows << "x" << cols << " distance\tstates\n";
+    for (std::size_t d = 0; d < table.histogram().size(); ++d)
+        histogram << d << '\t' << table.histogram()[d] << '\n';
+
+    if (reached != table.stateCount())
+    {
+        std::cerr << "BFS did not reach every solvable state\n";
+        return 1;
+    }
+
+    if (!output.empty())
+    {
+        DistanceTable check;
+        if (!table.save(output) || !check.load(output) || check.maxDistance() != table.maxDistance())
+        {
+            std::cerr << "Failed to write " << output << "\n";
+            return 1;
+        }
+        std::cerr << "Wrote " << output << "\n";
+    }
+    return 0;
+}
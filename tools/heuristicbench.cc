@@ -0,0 +1,186 @@
+// Nodes expanded and table memory of every solver heuristic on the same positions.
+//
+// Usage: Puzzle15_hbench [--threads N] [--count K] [--pdb file.pdb] [--tt MB] [input.txt]
+//
+// Solves the first K positions of the input (default: all of data/korf100.txt)
+// with Manhattan + linear conflict, walking distance and, when the file can be
+// loaded, the pattern database. Positions run in parallel on the pool; search
+// time is summed per position, so nodes/s is per core. With --tt, each
+// heuristic runs a second time ("md+tt", ...) with a transposition table of
+// that size shared by all positions. Prints one row per run:
+//   heuristic  table bytes  setup ms  mean h0  nodes  nodes vs md  search s  Mnodes/s  tt hits %  errors
+// Lines may end with "# ... <optimal length>"; other lengths count as errors.
+
+#include "patternDB.hh"
+#include "solver.hh"
+#include "threadPool.hh"
+#include "transpositionTable.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Instance
+    {
+        std::array<int, 16> board;
+        int emptyIdx;
+        int expected; // -1 if the line gives no optimal length
+    };
+
+    // The last number of the trailing comment, if any
+    int expectedLength(const std::string &line)
+    {
+        const std::size_t comment = line.find('#');
+        if (comment == std::string::npos)
+            return -1;
+        const std::size_t end = line.find_last_of("0123456789");
+        if (end == std::string::npos || end < comment)
+            return -1;
+        const std::size_t begin = line.find_last_not_of("0123456789", end) + 1;
+        return std::stoi(line.substr(begin, end + 1 - begin));
+    }
+
+    struct Totals
+    {
+        std::mutex mutex;
+        std::uint64_t nodes = 0;
+        std::uint64_t initialBounds = 0;
+        double searchSeconds = 0.0;
+        std::uint64_t probes = 0, hits = 0; // transposition table
+        int errors = 0;
+    };
+
+    double millisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned threads = 0;
+    std::size_t count = 0;
+    std::string pdbPath = "assets/pdb/puzzle15-663.pdb";
+    std::string inputPath = "data/korf100.txt";
+    std::size_t tableMegabytes = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--count" && i + 1 < argc)
+            count = std::stoul(argv[++i]);
+        else if (arg == "--pdb" && i + 1 < argc)
+            pdbPath = argv[++i];
+        else if (arg == "--tt" && i + 1 < argc)
+            tableMegabytes = std::stoul(argv[++i]);
+        else if (arg == "--help" || arg == "-h")
+        {
+            std::cerr << "Usage: " << argv[0] << " [--threads N] [--count K] [--pdb file.pdb] [--tt MB] [input.txt]\n";
+            return 0;
+        }
+        else
+            inputPath = arg;
+    }
+
+    std::ifstream input(inputPath);
+    if (!input)
+    {
+        std::cerr << "Cannot open " << inputPath << "\n";
+        return 1;
+    }
+
+    std::vector<Instance> instances;
+    std::string line;
+    while (std::getline(input, line) && (count == 0 || instances.size() < count))
+    {
+        if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+        Instance instance;
+        if (!parseBoard(line, instance.board) || !isSolvable(instance.board))
+        {
+            std::cerr << "Skipping invalid position: " << line << "\n";
+            continue;
+        }
+        instance.emptyIdx = 0;
+        while (instance.board[instance.emptyIdx] != 0)
+            ++instance.emptyIdx;
+        instance.expected = expectedLength(line);
+        instances.push_back(instance);
+    }
+
+    WorkStealingPool pool(threads);
+    std::cerr << "Solving " << instances.size() << " positions per heuristic on " << pool.size() << " threads\n";
+    std::printf("heuristic\ttable bytes\tsetup ms\tmean h0\tnodes\tnodes vs md\tsearch s\tMnodes/s\ttt hits %%\terrors\n");
+
+    std::uint64_t baselineNodes = 0;
+    int failures = 0;
+    auto run = [&](const std::string &name, const SolverOptions &options, std::size_t tableBytes, double setupMs)
+    {
+        Totals totals;
+        for (const Instance &instance : instances)
+            pool.submit([&]
+                        {
+                            const SolverResult result = solvePuzzle(instance.board, instance.emptyIdx, options);
+                            const bool wrong = !result.solved ||
+                                               (instance.expected >= 0 && static_cast<int>(result.moves.size()) != instance.expected);
+                            std::lock_guard lock(totals.mutex);
+                            totals.nodes += result.stats.nodesExpanded;
+                            totals.initialBounds += result.stats.initialBound;
+                            totals.searchSeconds += result.stats.seconds;
+                            totals.probes += result.stats.transpositionProbes;
+                            totals.hits += result.stats.transpositionHits;
+                            totals.errors += wrong; });
+        pool.wait();
+
+        if (baselineNodes == 0)
+            baselineNodes = totals.nodes;
+        const double positions = instances.empty() ? 1.0 : static_cast<double>(instances.size());
+        std::printf("%s\t%zu\t%.1f\t%.2f\t%llu\t%.3f\t%.3f\t%.2f\t%.1f\t%d\n", name.c_str(), tableBytes, setupMs,
+                    totals.initialBounds / positions, static_cast<unsigned long long>(totals.nodes),
+                    baselineNodes ? static_cast<double>(totals.nodes) / baselineNodes : 0.0, totals.searchSeconds,
+                    totals.searchSeconds > 0.0 ? totals.nodes / totals.searchSeconds / 1e6 : 0.0,
+                    totals.probes ? 100.0 * totals.hits / totals.probes : 0.0, totals.errors);
+        std::fflush(stdout);
+        failures += totals.errors;
+    };
+
+    PatternDatabase patterns;
+    for (const char *name : {"md", "wd", "pdb"})
+    {
+        // Setup covers what the heuristic needs before the first search: nothing, a BFS, or a file mapping
+        SolverOptions options;
+        const auto setupStart = std::chrono::steady_clock::now();
+        if (std::string(name) == "wd")
+            options.heuristic = SolverHeuristic::WalkingDistance;
+        else if (std::string(name) == "pdb")
+        {
+            if (!patterns.load(pdbPath))
+            {
+                std::cerr << "No pattern database at " << pdbPath << ", skipping pdb\n";
+                continue;
+            }
+            options.heuristic = SolverHeuristic::PatternDatabase;
+            options.patterns = &patterns;
+        }
+        const std::size_t tableBytes = heuristicTableBytes(options); // builds the walking-distance table
+        run(name, options, tableBytes, millisecondsSince(setupStart));
+
+        // Same heuristic with a fresh transposition table shared by all positions
+        if (tableMegabytes > 0)
+        {
+            const auto tableStart = std::chrono::steady_clock::now();
+            TranspositionTable transpositions(tableMegabytes << 20);
+            options.transpositions = &transpositions;
+            run(std::string(name) + "+tt", options, tableBytes + transpositions.bytes(), millisecondsSince(tableStart));
+        }
+    }
+    return failures ? 2 : 0;
+}
@@ -0,0 +1,28 @@
+// Packs the assets the game actually uses into one indexed archive.
+//
+// Usage: Puzzle15_pack <assets-dir> <output.pak> <relative-path>...
+//
+// The game memory-maps the archive and loads fonts and audio straight from
+// the mapping, falling back to the loose files when no archive is present.
+
+#include "assetArchive.hh"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <assets-dir> <output.pak> <relative-path>...\n";
+        return 1;
+    }
+
+    std::string root = argv[1];
+    if (!root.empty() && root.back() != '/' && root.back() != '\\')
+        root += '/';
+
+    std::vector<std::string> names(argv + 3, argv + argc);
+    return writeAssetArchive(root, names, argv[2], std::cout) ? 0 : 1;
+}
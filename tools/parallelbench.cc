@@ -0,0 +1,166 @@
+// Speedup of the root-split parallel solver on single hard positions.
+//
+// Usage: Puzzle15_parbench [--threads N] [--count K] [--pdb file.pdb] [--verbose] [input.txt]
+//
+// Solves every position of the input (default data/korf100.txt, the Korf 100
+// benchmark) one at a time with solvePuzzleParallel(), once per thread count
+// 1, 2, 4, ... up to N (default: all hardware threads, N itself is always
+// included). Lines may end with "# ... <optimal length>"; solutions of a
+// different length are reported as errors. Prints one row per thread count:
+//   threads  seconds  speedup  efficiency  nodes  Mnodes/s  errors
+// Per-position times for the highest thread count go to stderr with --verbose.
+
+#include "patternDB.hh"
+#include "solver.hh"
+#include "threadPool.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Instance
+    {
+        std::array<int, 16> board;
+        int emptyIdx;
+        int expected; // -1 if the line gives no optimal length
+    };
+
+    // The last number of the trailing comment, if any
+    int expectedLength(const std::string &line)
+    {
+        const std::size_t comment = line.find('#');
+        if (comment == std::string::npos)
+            return -1;
+        const std::size_t end = line.find_last_of("0123456789");
+        if (end == std::string::npos || end < comment)
+            return -1;
+        const std::size_t begin = line.find_last_not_of("0123456789", end) + 1;
+        return std::stoi(line.substr(begin, end + 1 - begin));
+    }
+
+    struct Run
+    {
+        double seconds = 0.0;
+        std::uint64_t nodes = 0;
+        int errors = 0;
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t count = 0;
+    bool verbose = false;
+    std::string pdbPath = "assets/pdb/puzzle15-663.pdb";
+    std::string inputPath = "data/korf100.txt";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            maxThreads = std::max(1u, static_cast<unsigned>(std::stoul(argv[++i])));
+        else if (arg == "--count" && i + 1 < argc)
+            count = std::stoul(argv[++i]);
+        else if (arg == "--pdb" && i + 1 < argc)
+            pdbPath = argv[++i];
+        else if (arg == "--verbose")
+            verbose = true;
+        else if (arg == "--help" || arg == "-h")
+        {
+            std::cerr << "Usage: " << argv[0] << " [--threads N] [--count K] [--pdb file.pdb] [--verbose] [input.txt]\n";
+            return 0;
+        }
+        else
+            inputPath = arg;
+    }
+
+    std::ifstream input(inputPath);
+    if (!input)
+    {
+        std::cerr << "Cannot open " << inputPath << "\n";
+        return 1;
+    }
+
+    std::vector<Instance> instances;
+    std::string line;
+    while (std::getline(input, line) && (count == 0 || instances.size() < count))
+    {
+        if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+        Instance instance;
+        if (!parseBoard(line, instance.board) || !isSolvable(instance.board))
+        {
+            std::cerr << "Skipping invalid position: " << line << "\n";
+            continue;
+        }
+        instance.emptyIdx = 0;
+        while (instance.board[instance.emptyIdx] != 0)
+            ++instance.emptyIdx;
+        instance.expected = expectedLength(line);
+        instances.push_back(instance);
+    }
+
+    PatternDatabase patterns;
+    SolverOptions options;
+    if (patterns.load(pdbPath))
+    {
+        options.heuristic = SolverHeuristic::PatternDatabase;
+        options.patterns = &patterns;
+        std::cerr << "Using " << patterns.describe() << " pattern database " << pdbPath << "\n";
+    }
+    else
+        std::cerr << "No pattern database at " << pdbPath << ", using Manhattan + linear conflict\n";
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < maxThreads; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    std::cerr << "Solving " << instances.size() << " positions one at a time\n";
+    std::printf("threads\tseconds\tspeedup\tefficiency\tnodes\tMnodes/s\terrors\n");
+
+    double baseline = 0.0;
+    int failures = 0;
+    for (unsigned threads : threadCounts)
+    {
+        WorkStealingPool pool(threads);
+        Run run;
+        for (std::size_t i = 0; i < instances.size(); ++i)
+        {
+            const Instance &instance = instances[i];
+            const auto start = std::chrono::steady_clock::now();
+            const SolverResult result = solvePuzzleParallel(instance.board, instance.emptyIdx, pool, options);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            run.seconds += seconds;
+            run.nodes += result.stats.nodesExpanded;
+            const int length = static_cast<int>(result.moves.size());
+            if (!result.solved || (instance.expected >= 0 && length != instance.expected))
+            {
+                ++run.errors;
+                std::cerr << "Position " << i + 1 << ": got " << length << " moves, expected "
+                          << instance.expected << "\n";
+            }
+            if (verbose && threads == threadCounts.back())
+                std::cerr << i + 1 << '\t' << length << '\t' << result.stats.nodesExpanded << '\t'
+                          << seconds * 1000.0 << " ms\n";
+        }
+
+        if (threads == 1)
+            baseline = run.seconds;
+        const double speedup = run.seconds > 0.0 ? baseline / run.seconds : 0.0;
+        std::printf("%u\t%.3f\t%.2f\t%.2f\t%llu\t%.2f\t%d\n", threads, run.seconds, speedup, speedup / threads,
+                    static_cast<unsigned long long>(run.nodes), run.seconds > 0.0 ? run.nodes / run.seconds / 1e6 : 0.0,
+                    run.errors);
+        std::fflush(stdout);
+        failures += run.errors;
+    }
+    return failures ? 2 : 0;
+}
@@ -0,0 +1,195 @@
+// Bulk generator of random puzzle positions.
+//
+// Usage: Puzzle15_gen [--size N] [--count K] [--seed S] [--threads T]
+//                     [--distance D [--pdb file.pdb] [--attempts A]] [--benchmark]
+//
+// Without --distance, prints K uniformly random solvable N x N positions
+// (default 4x4). With --distance, prints 4x4 positions whose optimal solution
+// is exactly D moves (use the pattern database for targets above ~40). Each
+// position gets up to A solved candidates (default 256); targets above 60 are
+// rare among random positions and may run out, which stops the run with an
+// error after printing the positions before the first failed one (also the
+// same for every thread count).
+// One position per line, row-major, 0 = empty: the format Puzzle15_batch reads.
+// Output only depends on --seed, not on the thread count. --benchmark skips
+// the output and only reports the generation rate on stderr.
+
+#include "board.hh"
+#include "patternDB.hh"
+#include "puzzleGenerator.hh"
+#include "threadPool.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint64_t UNIFORM_CHUNK = 65536; // positions per task (uniform mode)
+    constexpr std::uint64_t DISTANCE_CHUNK = 16;   // positions per task (exact-distance mode)
+
+    // Independent, reproducible stream per chunk
+    std::uint64_t chunkSeed(std::uint64_t seed, std::uint64_t chunk)
+    {
+        std::seed_seq sequence{seed & 0xFFFFFFFF, seed >> 32, chunk & 0xFFFFFFFF, chunk >> 32};
+        std::uint32_t words[2];
+        sequence.generate(words, words + 2);
+        return (std::uint64_t(words[0]) << 32) | words[1];
+    }
+
+    void appendPosition(std::string &out, std::span<const int> tiles)
+    {
+        for (std::size_t i = 0; i < tiles.size(); ++i)
+        {
+            if (i)
+                out += ' ';
+            out += std::to_string(tiles[i]);
+        }
+        out += '\n';
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int size = 4;
+    std::uint64_t count = 1;
+    std::uint64_t seed = std::random_device{}();
+    unsigned threads = 0;
+    int distance = -1;
+    int maxAttempts = PuzzleGenerator::DEFAULT_MAX_ATTEMPTS;
+    bool benchmark = false;
+    std::string pdbPath = "assets/pdb/puzzle15-663.pdb";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc)
+            size = std::clamp(std::stoi(argv[++i]), MIN_BOARD_SIZE, MAX_BOARD_SIZE);
+        else if (arg == "--count" && i + 1 < argc)
+            count = std::stoull(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = std::stoull(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--distance" && i + 1 < argc)
+            distance = std::stoi(argv[++i]);
+        else if (arg == "--attempts" && i + 1 < argc)
+            maxAttempts = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--pdb" && i + 1 < argc)
+            pdbPath = argv[++i];
+        else if (arg == "--benchmark")
+            benchmark = true;
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--size N] [--count K] [--seed S] [--threads T]\n"
+                      << "       [--distance D [--pdb file.pdb] [--attempts A]] [--benchmark]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    if (distance >= 0 && size != 4)
+    {
+        std::cerr << "--distance needs the optimal solver, which only handles 4x4 boards\n";
+        return 1;
+    }
+
+    if (distance > PuzzleGenerator::MAX_DISTANCE)
+    {
+        std::cerr << "No 4x4 position is more than " << PuzzleGenerator::MAX_DISTANCE << " moves from the goal\n";
+        return 1;
+    }
+    if (distance > PuzzleGenerator::PRACTICAL_MAX_DISTANCE)
+        std::cerr << "Warning: positions " << distance << " moves out are rare; each may take minutes or exhaust "
+                  << maxAttempts << " attempts\n";
+
+    PatternDatabase patterns;
+    SolverOptions options;
+    if (distance >= 0 && patterns.load(pdbPath))
+    {
+        options.heuristic = SolverHeuristic::PatternDatabase;
+        options.patterns = &patterns;
+    }
+
+    const std::uint64_t chunkSize = distance >= 0 ? DISTANCE_CHUNK : UNIFORM_CHUNK;
+    const std::uint64_t chunks = (count + chunkSize - 1) / chunkSize;
+    std::vector<std::string> output(benchmark ? 0 : chunks);
+    std::vector<GeneratorStats> stats(chunks);
+
+    WorkStealingPool pool(threads);
+    // First chunk with a position that ran out of attempts; later chunks are dropped, earlier ones finish
+    constexpr std::uint64_t NO_FAILURE = ~0ull;
+    std::atomic<std::uint64_t> failedChunk{NO_FAILURE};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t chunk = 0; chunk < chunks; ++chunk)
+        pool.submit([&, chunk]
+                    {
+                        const std::uint64_t n = std::min(chunkSize, count - chunk * chunkSize);
+                        std::string *out = benchmark ? nullptr : &output[chunk];
+                        if (distance >= 0)
+                        {
+                            PuzzleGenerator generator(chunkSeed(seed, chunk), options);
+                            for (std::uint64_t i = 0; i < n && failedChunk.load(std::memory_order_relaxed) > chunk; ++i)
+                            {
+                                const std::optional<Board<4>> board = generator.atDistance(distance, maxAttempts);
+                                if (!board)
+                                {
+                                    std::uint64_t first = failedChunk.load();
+                                    while (chunk < first && !failedChunk.compare_exchange_weak(first, chunk))
+                                    {
+                                    }
+                                    break;
+                                }
+                                if (out)
+                                    appendPosition(*out, board->tiles);
+                            }
+                            stats[chunk] = generator.stats();
+                        }
+                        else
+                        {
+                            RandomEngine rng(chunkSeed(seed, chunk));
+                            PuzzleBoard board(size);
+                            for (std::uint64_t i = 0; i < n; ++i)
+                            {
+                                board.shuffle(rng);
+                                if (out)
+                                    appendPosition(*out, board.tiles());
+                            }
+                            stats[chunk].generated = n;
+                        } });
+    pool.wait();
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Positions in sequence order up to the first failure, so the output only depends on the seed
+    const std::uint64_t lastChunk = std::min(failedChunk.load(), chunks - 1);
+    std::uint64_t generated = 0, attempts = 0, nodes = 0;
+    for (std::uint64_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        if (chunk <= lastChunk)
+        {
+            generated += stats[chunk].generated;
+            if (!benchmark)
+                std::cout << output[chunk];
+        }
+        attempts += stats[chunk].attempts;
+        nodes += stats[chunk].nodesExpanded;
+    }
+
+    std::cerr << "Generated " << generated << " " << size << "x" << size << " positions";
+    if (distance >= 0)
+        std::cerr << " at distance " << distance << " (" << attempts << " candidates solved, " << nodes
+                  << " nodes, " << (options.patterns ? "pattern database" : "Manhattan + linear conflict") << ")";
+    std::cerr << " on " << pool.size() << " threads in " << wall << " s: "
+              << (wall > 0 ? generated / wall : 0.0) << " positions/s\n";
+    if (generated < count)
+    {
+        std::cerr << "Stopped after " << generated << " of " << count << " positions: no candidate reached distance "
+                  << distance << " within " << maxAttempts << " attempts\n";
+        return 1;
+    }
+    return 0;
+}
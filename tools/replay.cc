@@ -0,0 +1,152 @@
+// Headless replay of recorded game sessions.
+//
+// Usage: Puzzle15_replay [--threads N] [--verbose] <sessions.rpl>...
+//        Puzzle15_replay --synthesize <count> <output.rpl>
+//
+// Every file may hold any number of concatenated sessions (the game writes
+// one per run when PUZZLE15_REPLAY_LOG is set). Each session is re-run
+// through GameState with a manual clock on all cores; --verbose prints
+//   <file>\t<session>\t<size>\t<moves>\t<won>\t<milliseconds>
+// per session. A throughput summary is written to stderr.
+//
+// --synthesize records random 3x3 sessions (useful to benchmark replay speed).
+
+#include "gameState.hh"
+#include "mappedFile.hh"
+#include "replay.hh"
+#include "threadPool.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Session
+    {
+        std::size_t file;
+        std::size_t index;
+        std::span<const unsigned char> bytes;
+    };
+
+    // Random players: restart a 3x3 game and click random neighbors of the empty cell
+    bool synthesize(std::uint64_t count, const std::string &path)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        RandomEngine rng(12345);
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            ManualGameClock clock;
+            std::uint64_t now = 1000;
+            clock.set(now);
+            GameState game(clock, rng());
+            ReplayWriter writer(game.seed(), now);
+            game.setRecorder(&writer);
+
+            game.restart(3);
+            const int moves = 20 + static_cast<int>(rng() % 200);
+            for (int m = 0; m < moves && !game.won(); ++m)
+            {
+                now += 100 + rng() % 900;
+                clock.set(now);
+                const int empty = game.board().emptyIdx();
+                const int dx[4] = {-1, 1, 0, 0}, dy[4] = {0, 0, -1, 1};
+                const int d = static_cast<int>(rng() % 4);
+                game.tryMove(empty % 3 + dx[d], empty / 3 + dy[d]);
+                game.clearEvents();
+            }
+
+            writer.end(now);
+            const std::vector<unsigned char> bytes = writer.serialize();
+            out.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        }
+        std::cerr << "Wrote " << count << " sessions to " << path << "\n";
+        return static_cast<bool>(out);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned threads = 0;
+    bool verbose = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--verbose")
+            verbose = true;
+        else if (arg == "--synthesize" && i + 2 < argc)
+            return synthesize(std::stoull(argv[i + 1]), argv[i + 2]) ? 0 : 1;
+        else if (arg == "--help" || arg == "-h")
+        {
+            std::cerr << "Usage: " << argv[0] << " [--threads N] [--verbose] <sessions.rpl>...\n"
+                      << "       " << argv[0] << " --synthesize <count> <output.rpl>\n";
+            return 0;
+        }
+        else
+            paths.push_back(arg);
+    }
+
+    // Map every file and split it into sessions (headers carry their length)
+    std::vector<MappedFile> files(paths.size());
+    std::vector<Session> sessions;
+    std::uint64_t bytes = 0;
+    for (std::size_t f = 0; f < paths.size(); ++f)
+    {
+        if (!files[f].open(paths[f]))
+        {
+            std::cerr << "Cannot open " << paths[f] << "\n";
+            return 1;
+        }
+
+        std::span<const unsigned char> rest(files[f].data(), files[f].size());
+        bytes += rest.size();
+        ReplayReader reader;
+        while (!rest.empty() && reader.open(rest))
+        {
+            sessions.push_back({f, sessions.size(), rest.first(reader.sessionBytes())});
+            rest = rest.subspan(reader.sessionBytes());
+        }
+        if (!rest.empty())
+            std::cerr << paths[f] << ": " << rest.size() << " trailing bytes are not a replay\n";
+    }
+
+    std::vector<ReplayResult> results(sessions.size());
+    WorkStealingPool pool(threads);
+    const auto start = std::chrono::steady_clock::now();
+
+    constexpr std::size_t CHUNK = 4096; // sessions per task
+    for (std::size_t first = 0; first < sessions.size(); first += CHUNK)
+        pool.submit([&, first]
+                    {
+                        const std::size_t last = std::min(first + CHUNK, sessions.size());
+                        for (std::size_t i = first; i < last; ++i)
+                            results[i] = replaySession(sessions[i].bytes); });
+    pool.wait();
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::uint64_t records = 0, wins = 0, invalid = 0;
+    for (std::size_t i = 0; i < sessions.size(); ++i)
+    {
+        const ReplayResult &r = results[i];
+        records += r.records;
+        wins += r.won;
+        invalid += !r.valid;
+        if (verbose)
+            std::cout << paths[sessions[i].file] << '\t' << i << '\t' << r.size << '\t' << r.moveCount << '\t'
+                      << (r.valid ? (r.won ? "won" : "open") : "invalid") << '\t' << r.elapsedMilliseconds << '\n';
+    }
+
+    std::cerr << "Replayed " << sessions.size() << " sessions (" << records << " records, " << bytes
+              << " bytes) on " << pool.size() << " threads in " << wall << " s: "
+              << (wall > 0 ? sessions.size() / wall : 0.0) << " sessions/s, "
+              << (wall > 0 ? records / wall : 0.0) << " records/s; " << wins << " won, " << invalid << " invalid\n";
+    return invalid ? 2 : 0;
+}
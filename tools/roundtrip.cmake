@@ -0,0 +1,50 @@
+# Batch solver -> move archive -> validator round trip (run by ctest).
+#
+# Usage: cmake -DGEN=<Puzzle15_gen> -DBATCH=<Puzzle15_batch> -DVALIDATE=<Puzzle15_validate>
+#              -DWORK_DIR=<dir> -P roundtrip.cmake
+#
+# Generates 4x4 positions at a known distance, solves them with --archive and
+# checks that every archived solution replays legally to the goal and is
+# optimal. Fails on any non-zero exit code or unsolved position.
+
+set(POSITIONS ${WORK_DIR}/roundtrip.txt)
+set(SOLUTIONS ${WORK_DIR}/roundtrip.out)
+set(ARCHIVE ${WORK_DIR}/roundtrip.mv)
+set(COUNT 24)
+
+execute_process(
+    COMMAND ${GEN} --distance 30 --count ${COUNT} --seed 15
+    OUTPUT_FILE ${POSITIONS}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Puzzle15_gen failed (${result})")
+endif()
+
+execute_process(
+    COMMAND ${BATCH} --heuristic wd --archive ${ARCHIVE} ${POSITIONS}
+    OUTPUT_FILE ${SOLUTIONS}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Puzzle15_batch failed (${result})")
+endif()
+
+file(STRINGS ${SOLUTIONS} solved REGEX "^[0-9]+\t30\t")
+list(LENGTH solved solvedCount)
+if(NOT solvedCount EQUAL COUNT)
+    message(FATAL_ERROR "Puzzle15_batch solved ${solvedCount} of ${COUNT} positions at length 30")
+endif()
+
+execute_process(
+    COMMAND ${VALIDATE} --optimal --verbose ${ARCHIVE}
+    ERROR_VARIABLE summary
+    RESULT_VARIABLE result
+)
+message(STATUS "${summary}")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Puzzle15_validate rejected the archive (${result})")
+endif()
+if(NOT summary MATCHES "Validated ${COUNT} records")
+    message(FATAL_ERROR "Puzzle15_validate did not see all ${COUNT} records")
+endif()
@@ -0,0 +1,126 @@
+// Throughput of the batch heuristic evaluation (simdHeuristics.hh) per instruction set.
+//
+// Usage: Puzzle15_simdbench [--count N] [--batch B]
+//
+// Builds N random 4x4 boards (plus the goal and boards a few moves from it,
+// so the solved flag is exercised), checks that every level the CPU supports
+// returns exactly the scalar results (and that the scalar Manhattan distance
+// matches the solver's), then times evaluateBoards() over batches of B boards
+// (default 32) and prints Mboards/s and the speedup over the scalar path.
+
+#include "board.hh"
+#include "simdHeuristics.hh"
+#include "solver.hh"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Boards near the goal, so solved == 1 and small distances occur
+    PackedBoard randomWalk(RandomEngine &rng, int steps)
+    {
+        Board<4> board;
+        for (int i = 0; i < steps; ++i)
+        {
+            const int target = PACKED_MOVES.target[board.emptyIdx][rng() % PACKED_MOVES.count[board.emptyIdx]];
+            std::swap(board.tiles[board.emptyIdx], board.tiles[target]);
+            board.emptyIdx = target;
+        }
+        return packBoard(board.tiles);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t count = 1 << 20;
+    std::size_t batch = 32;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--count" && i + 1 < argc)
+            count = std::max<std::size_t>(1, std::stoull(argv[++i]));
+        else if (arg == "--batch" && i + 1 < argc)
+            batch = std::max<std::size_t>(1, std::stoull(argv[++i]));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--count N] [--batch B]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    RandomEngine rng(2024);
+    std::vector<PackedBoard> boards(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i % 16 == 0)
+            boards[i] = randomWalk(rng, static_cast<int>(rng() % 6));
+        else
+        {
+            Board<4> board;
+            shuffleBoard(board, rng);
+            boards[i] = packBoard(board.tiles);
+        }
+    }
+
+    // Bit-exact check of every available level against the scalar reference
+    const SimdLevel best = detectSimdLevel();
+    std::vector<BoardEstimate> reference(count), results(count);
+    evaluateBoards(boards, reference, SimdLevel::Scalar);
+    int failures = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        if (reference[i].manhattan != manhattanDistance(unpackBoard(boards[i])) ||
+            reference[i].solved != isSolvedPacked(boards[i]))
+        {
+            ++failures;
+            break;
+        }
+
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2})
+        if (level >= best)
+            levels.push_back(level);
+
+    for (SimdLevel level : levels)
+    {
+        std::fill(results.begin(), results.end(), BoardEstimate{0xFF, 0xFF, 0xFF});
+        // Odd batch sizes exercise the tail handling
+        for (std::size_t first = 0; first < count; first += 7)
+        {
+            const std::size_t n = std::min<std::size_t>(7, count - first);
+            evaluateBoards(std::span(boards).subspan(first, n), std::span(results).subspan(first, n), level);
+        }
+        if (std::memcmp(results.data(), reference.data(), count * sizeof(BoardEstimate)) != 0)
+        {
+            std::cerr << simdLevelName(level) << ": results differ from the scalar path\n";
+            ++failures;
+        }
+    }
+
+    std::cout << "CPU level: " << simdLevelName(best) << ", " << count << " boards in batches of " << batch << "\n";
+    double scalarRate = 0.0;
+    std::uint64_t checksum = 0;
+    for (SimdLevel level : levels)
+    {
+        const int passes = 8;
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass)
+            for (std::size_t first = 0; first < count; first += batch)
+            {
+                const std::size_t n = std::min(batch, count - first);
+                evaluateBoards(std::span(boards).subspan(first, n), std::span(results).subspan(first, n), level);
+                checksum += results[first].manhattan;
+            }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double rate = seconds > 0 ? passes * count / seconds : 0.0;
+        if (level == SimdLevel::Scalar)
+            scalarRate = rate;
+        std::cout << simdLevelName(level) << ":\t" << rate / 1e6 << " Mboards/s\t"
+                  << (scalarRate > 0 ? rate / scalarRate : 0.0) << "x scalar\n";
+    }
+    std::cout << (failures ? "MISMATCH" : "All levels bit-exact") << " (checksum " << checksum << ")\n";
+    return failures ? 2 : 0;
+}
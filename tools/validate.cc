@@ -0,0 +1,274 @@
+// Streaming validator of archived move sequences (moveCodec.hh records).
+//
+// Usage: Puzzle15_validate [--threads N] [--optimal] [--pdb file.pdb] [--verbose] <records.mv>...
+//        Puzzle15_validate --synthesize <count> <output.mv>
+//
+// Files are memory-mapped and split into chunks of records that are
+// replayed on all cores with the game's move rules; every record must stay
+// on the board and end solved. --optimal also compares each solved record
+// with the optimal length: 3x3 from the exact distance table (built in
+// memory), 4x4 with the IDA* solver (pattern database if it loads, walking
+// distance otherwise; slow on long files), and reports longer sequences as
+// suboptimal. --verbose prints one line per failing record:
+//   <file>\t<record>\t<bad start position | illegal move N | unsolved | suboptimal M > optimal>
+// A summary with throughput goes to stderr; the exit code is 2 if any
+// record is invalid, unsolved or (with --optimal) suboptimal.
+//
+// --synthesize writes random 3x3/4x4 records (scrambling walks played back
+// to the goal) for throughput tests.
+
+#include "board.hh"
+#include "distanceTable.hh"
+#include "mappedFile.hh"
+#include "moveCodec.hh"
+#include "patternDB.hh"
+#include "solver.hh"
+#include "threadPool.hh"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t CHUNK_RECORDS = 65536; // records per task
+
+    struct Chunk
+    {
+        std::size_t file;
+        std::uint64_t firstRecord;
+        std::span<const unsigned char> bytes; // whole records only
+    };
+
+    struct Tally
+    {
+        std::uint64_t records = 0, moves = 0;
+        std::uint64_t invalid = 0, unsolved = 0;
+        std::uint64_t optimalChecked = 0, suboptimal = 0;
+
+        void add(const Tally &other)
+        {
+            records += other.records;
+            moves += other.moves;
+            invalid += other.invalid;
+            unsolved += other.unsolved;
+            optimalChecked += other.optimalChecked;
+            suboptimal += other.suboptimal;
+        }
+    };
+
+    // Optimal length of a solved record's start position, or -1 if no oracle covers its size
+    struct OptimalOracle
+    {
+        const DistanceTable *table3 = nullptr;
+        SolverOptions options;
+
+        int length(const MoveRecordReader &record) const
+        {
+            const std::span<const unsigned char> start = record.startTiles();
+            if (record.size() == 3 && table3)
+            {
+                std::array<int, 9> tiles;
+                std::copy(start.begin(), start.end(), tiles.begin());
+                return table3->distance(tiles);
+            }
+            if (record.size() == 4)
+            {
+                std::array<int, 16> tiles;
+                std::copy(start.begin(), start.end(), tiles.begin());
+                const int empty = static_cast<int>(std::find(tiles.begin(), tiles.end(), 0) - tiles.begin());
+                const SolverResult result = solvePuzzle(tiles, empty, options);
+                return result.solved ? static_cast<int>(result.moves.size()) : -1;
+            }
+            return -1;
+        }
+    };
+
+    // Scrambling walk from the goal, stored as the start plus the walk played backwards
+    bool synthesize(std::uint64_t count, const std::string &path)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        RandomEngine rng(777);
+        std::vector<unsigned char> buffer;
+        std::vector<int> walk;
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            const int size = i % 2 ? 4 : 3;
+            PuzzleBoard board(size);
+            walk.clear();
+            const int steps = 20 + static_cast<int>(rng() % 100);
+            while (static_cast<int>(walk.size()) < steps)
+            {
+                const int empty = board.emptyIdx();
+                const int dx[4] = {0, 0, -1, 1}, dy[4] = {-1, 1, 0, 0};
+                const int d = static_cast<int>(rng() % 4);
+                if (!walk.empty() && empty + dx[d] + dy[d] * size == walk.back())
+                    continue; // no immediate reversals
+                if (board.moveTile(empty % size + dx[d], empty / size + dy[d]))
+                    walk.push_back(empty);
+            }
+
+            // walk holds where the blank came from; replaying it backwards returns to the goal
+            std::reverse(walk.begin(), walk.end());
+            const std::span<const int> tiles = board.tiles();
+            encodeMoves(size, tiles, walk, buffer);
+            if (buffer.size() > (1 << 20))
+            {
+                out.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+                buffer.clear();
+            }
+        }
+        out.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+        std::cerr << "Wrote " << count << " records to " << path << "\n";
+        return static_cast<bool>(out);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned threads = 0;
+    bool checkOptimal = false;
+    bool verbose = false;
+    std::string pdbPath = "assets/pdb/puzzle15-663.pdb";
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--optimal")
+            checkOptimal = true;
+        else if (arg == "--pdb" && i + 1 < argc)
+            pdbPath = argv[++i];
+        else if (arg == "--verbose")
+            verbose = true;
+        else if (arg == "--synthesize" && i + 2 < argc)
+            return synthesize(std::stoull(argv[i + 1]), argv[i + 2]) ? 0 : 1;
+        else if (arg == "--help" || arg == "-h")
+        {
+            std::cerr << "Usage: " << argv[0] << " [--threads N] [--optimal] [--pdb file.pdb] [--verbose] <records.mv>...\n"
+                      << "       " << argv[0] << " --synthesize <count> <output.mv>\n";
+            return 0;
+        }
+        else
+            paths.push_back(arg);
+    }
+
+    OptimalOracle oracle;
+    DistanceTable table3;
+    PatternDatabase patterns;
+    if (checkOptimal)
+    {
+        if (table3.build(3, 3, threads))
+            oracle.table3 = &table3;
+        oracle.options.heuristic = SolverHeuristic::WalkingDistance;
+        if (patterns.load(pdbPath))
+        {
+            oracle.options.heuristic = SolverHeuristic::PatternDatabase;
+            oracle.options.patterns = &patterns;
+        }
+    }
+
+    // Map every file and cut it into chunks at record boundaries (headers carry the lengths)
+    std::vector<MappedFile> files(paths.size());
+    std::vector<Chunk> chunks;
+    std::uint64_t bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t f = 0; f < paths.size(); ++f)
+    {
+        if (!files[f].open(paths[f]))
+        {
+            std::cerr << "Cannot open " << paths[f] << "\n";
+            return 1;
+        }
+
+        std::span<const unsigned char> rest(files[f].data(), files[f].size());
+        bytes += rest.size();
+        std::uint64_t records = 0;
+        MoveRecordReader reader;
+        while (!rest.empty())
+        {
+            std::size_t length = 0, count = 0;
+            while (count < CHUNK_RECORDS && reader.open(rest.subspan(length)))
+            {
+                length += reader.recordBytes();
+                ++count;
+            }
+            if (count == 0)
+                break;
+            chunks.push_back({f, records, rest.first(length)});
+            rest = rest.subspan(length);
+            records += count;
+        }
+        if (!rest.empty())
+            std::cerr << paths[f] << ": " << rest.size() << " trailing bytes are not a move record\n";
+    }
+
+    WorkStealingPool pool(threads);
+    std::mutex mutex;
+    Tally total;
+    for (const Chunk &chunk : chunks)
+        pool.submit([&]
+                    {
+                        Tally tally;
+                        std::string failures;
+                        std::span<const unsigned char> rest = chunk.bytes;
+                        MoveRecordReader reader;
+                        for (std::uint64_t index = chunk.firstRecord; reader.open(rest); ++index)
+                        {
+                            rest = rest.subspan(reader.recordBytes());
+                            const MoveCheck check = validateMoves(reader);
+                            ++tally.records;
+                            tally.moves += check.moves;
+
+                            std::string problem;
+                            if (!check.valid)
+                            {
+                                ++tally.invalid;
+                                problem = check.firstIllegal < 0 ? "bad start position"
+                                                                 : "illegal move " + std::to_string(check.firstIllegal);
+                            }
+                            else if (!check.solved)
+                            {
+                                ++tally.unsolved;
+                                problem = "unsolved";
+                            }
+                            else if (checkOptimal)
+                            {
+                                const int optimal = oracle.length(reader);
+                                if (optimal >= 0)
+                                {
+                                    ++tally.optimalChecked;
+                                    if (static_cast<int>(check.moves) > optimal)
+                                    {
+                                        ++tally.suboptimal;
+                                        problem = "suboptimal " + std::to_string(check.moves) + " > " + std::to_string(optimal);
+                                    }
+                                }
+                            }
+                            if (verbose && !problem.empty())
+                                failures += paths[chunk.file] + '\t' + std::to_string(index) + '\t' + problem + '\n';
+                        }
+
+                        std::lock_guard lock(mutex);
+                        total.add(tally);
+                        std::cout << failures; });
+    pool.wait();
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cerr << "Validated " << total.records << " records (" << total.moves << " moves, " << bytes << " bytes) on "
+              << pool.size() << " threads in " << wall << " s: " << (wall > 0 ? bytes / wall / 1e9 : 0.0) << " GB/s, "
+              << (wall > 0 ? total.moves / wall / 1e6 : 0.0) << " Mmoves/s; " << total.invalid << " invalid, "
+              << total.unsolved << " unsolved";
+    if (checkOptimal)
+        std::cerr << ", " << total.suboptimal << " of " << total.optimalChecked << " checked suboptimal";
+    std::cerr << "\n";
+    return total.invalid || total.unsolved || total.suboptimal ? 2 : 0;
+}